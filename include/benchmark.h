@@ -0,0 +1,37 @@
+/**
+ * @file benchmark.h
+ * @brief 不依赖redis的本地性能测试，通过 -t bench -B 名称 运行
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "order_workload.h"
+
+// 性能测试参数
+struct BenchOptions {
+    std::string name;          // 测试名称
+    int64_t count = 10000;     // 测试的订单数量
+    int64_t threads = 1;       // 并发测试的线程数
+    int64_t accountCount = 1;  // 并发测试的账户数量
+    std::shared_ptr<const WorkloadProfile> workload;  // 订单分布，为空时freeze和match使用各自的均匀分布
+};
+
+/**
+ * @brief 运行指定的性能测试并输出结果
+ * @param options 测试参数
+ * @return int 0-成功，其他-失败（名称不存在或者校验失败）
+ */
+int RunBenchmark(const BenchOptions& options);
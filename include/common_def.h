@@ -2,6 +2,14 @@
 
 #include <inttypes.h>
 
+#include <charconv>
+#include <cstring>
+
+#include "utils/fixed_point.h"
+
+using Price = library::utils::FixedPoint<4>;  // 价格，4位小数定点数
+using Money = library::utils::FixedPoint<4>;  // 金额，4位小数定点数
+
 struct Order {
     int32_t branch_no;       // 操作分支机构
     char client_id[32];      // 客户编号
@@ -16,8 +24,8 @@ struct Order {
     char entrust_prop;       // 委托属性
     char entrust_bs;         // 买卖方向
     int entrust_amount;      // 委托数量
-    double entrust_price;    // 委托价格
-    double entrust_money;    // 委托金额
+    Price entrust_price;     // 委托价格
+    Money entrust_money;     // 委托金额
     char registe_sure_flag;  // 是否已签署确认书
 
     // 委托生成数据
@@ -26,19 +34,42 @@ struct Order {
     int32_t entrust_no = 0;    // 委托编号
     int32_t report_no = 0;     // 申请编号
     char seat_no[6] = {0};     // 席位编号
-    double deal_price = 0;     // 成交价格
+    Price deal_price;          // 成交价格
     double deal_amount = 0;    // 成交数量
     double cancel_amount = 0;  // 撤销数量
     char entrust_status = 0;   // 委托状态
-    double fees = 0;           // 总费用
-    double freeze_money = 0;   // 冻结资金
+    Money fees;                // 总费用
+    Money freeze_money;        // 冻结资金
     int32_t update_time = 0;   // 委托更新时间
     char remark[256] = {};     // 提示说明
+    int64_t send_time = 0;     // 推送时间（Time::NowNano，纳秒），消费端据此统计端到端延迟，0-未知
 };
 
 struct AccountFund {
-    double fund_avl = 0;      // 可用资金
-    double fund_trd_frz = 0;  // 交易冻结
+    Money fund_avl;      // 可用资金
+    Money fund_trd_frz;  // 交易冻结
 };
 
 const int ACCOUNT_MAX = 5000000;
+
+const int64_t CLIENT_ID_BASE = 600000000001;     // 测试订单的起始客户编号
+const int64_t FUND_ACCOUNT_BASE = 700000000001;  // 测试订单的起始资产账户
+
+const char STREAM_ORDER_FIELD[] = "o";  // Stream队列中存放订单编码的字段名
+const char STREAM_ID_FIELD[] = "id";    // 死信Stream中存放原消息id的字段名
+const char DEAD_LETTER_SUFFIX[] = ":dead";  // 死信队列键的后缀，无法解码的消息按原队列类型移入queue_name_i:dead
+
+const char ORDER_NO_KEY[] = "order_no";                        // 订单编号计数器
+const char ACCOUNT_ORDER_COUNT_KEY[] = "account_order_count";  // 各资产账户的订单数（hash）
+
+/**
+ * @brief 将资产账户转换为数值
+ * @param fundAccount 资产账户
+ * @return int64_t 数值形式的资产账户，不是十进制数字时返回0
+ */
+inline int64_t ParseFundAccount(const char (&fundAccount)[32]) {
+    int64_t account = 0;
+    auto end = fundAccount + strnlen(fundAccount, sizeof(fundAccount));
+    auto res = std::from_chars(fundAccount, end, account);
+    return res.ec == std::errc() && res.ptr == end ? account : 0;
+}
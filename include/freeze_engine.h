@@ -0,0 +1,90 @@
+/**
+ * @file freeze_engine.h
+ * @brief 资金冻结/解冻，按账户CAS更新缩放后的整数余额，没有全局锁
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "common_def.h"
+#include "fund_ledger.h"
+
+/**
+ * @brief 冻结引擎
+ * 冻结时先CAS扣减可用资金（余额不足时拒绝），再原子增加冻结资金；解冻顺序相反。
+ * 每个字段单独保证不透支，两个字段之间的转移过程对并发读者可见（可用+冻结短暂小于总额）。
+ * 多个消费线程可以同时操作同一账户。
+ */
+class FreezeEngine {
+public:
+    explicit FreezeEngine(FundLedger& ledger)
+        : _ledger(ledger) {
+    }
+
+    /**
+     * @brief 订单需要冻结的资金：委托价格 * 委托数量
+     * @param order 订单
+     * @return Money 冻结资金
+     */
+    static Money FreezeAmount(const Order& order) { return order.entrust_price * order.entrust_amount; }
+
+    /**
+     * @brief 按订单冻结资金，只有买入委托冻结资金，卖出委托直接成功
+     * @param order 订单，成功时回填freeze_money（卖出委托为0）
+     * @return true 成功
+     * @return false 账户不存在或可用资金不足
+     */
+    bool Freeze(Order& order);
+
+    /**
+     * @brief 将可用资金转入冻结资金
+     * @param id 账户序号
+     * @param amount 金额，不能为负数
+     * @return true 成功
+     * @return false 可用资金不足或金额为负数
+     */
+    bool Freeze(int32_t id, Money amount);
+
+    /**
+     * @brief 将冻结资金转回可用资金
+     * @param id 账户序号
+     * @param amount 金额，不能为负数
+     * @return true 成功
+     * @return false 冻结资金不足或金额为负数
+     */
+    bool Unfreeze(int32_t id, Money amount);
+
+    /**
+     * @brief 增加可用资金
+     * @param id 账户序号
+     * @param amount 金额
+     */
+    void Deposit(int32_t id, Money amount);
+
+    /**
+     * @brief 重置账户资金，只在没有并发冻结时调用（如开盘前初始化）
+     * @param id 账户序号
+     * @param fundAvl 可用资金，冻结资金清零
+     */
+    void Reset(int32_t id, Money fundAvl);
+
+    /**
+     * @brief 读取账户资金
+     * @param id 账户序号
+     * @return AccountFund 资金
+     */
+    AccountFund Get(int32_t id) const;
+
+private:
+    FundLedger& _ledger;  // 资金账本
+};
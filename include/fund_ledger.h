@@ -0,0 +1,104 @@
+/**
+ * @file fund_ledger.h
+ * @brief 基于内存映射文件的资金账本，按稠密账户序号O(1)访问，进程重启后直接复用
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "common_def.h"
+
+// 资金槽位，每个账户独占一个缓存行，不同账户之间没有伪共享
+struct alignas(64) FundSlot {
+    AccountFund fund;      // 资金
+    int64_t account = 0;   // 资产账户，0表示槽位未使用
+};
+
+static_assert(sizeof(FundSlot) == 64, "FundSlot must fit in one cache line");
+
+/**
+ * @brief 资金账本
+ * 文件布局: | 文件头(64字节) | FundSlot * capacity | 索引(uint32 * indexSize) |
+ * 资产账户通过文件内的开放寻址索引映射为稠密序号[0, capacity)，索引项保存序号+1，账户值从槽位中读取。
+ * 新账户先以占位值抢占索引项，抢到后才分配槽位并写入账户，最后发布序号，并发新增同一账户时不会浪费槽位；
+ * 查找遇到占位值时等待其发布。进程在占位期间退出时，下次打开把残留的占位项改为作废项，查找时跳过。
+ * 查询和新增账户均无锁，可以多线程并发调用。
+ */
+class FundLedger {
+public:
+    /**
+     * @brief 构造函数，打开或创建账本文件，失败时抛出library::utils::Exception
+     * @param path 文件路径
+     * @param capacity 最大账户数，打开已有文件时必须与创建时一致
+     * @param preload 是否预加载并锁定全部页面，false时按需缺页加载，启动不依赖文件大小
+     */
+    FundLedger(const std::string& path, uint32_t capacity = ACCOUNT_MAX, bool preload = false);
+    ~FundLedger();
+
+    FundLedger(const FundLedger&) = delete;
+    FundLedger& operator=(const FundLedger&) = delete;
+
+    /**
+     * @brief 查询账户序号
+     * @param account 资产账户
+     * @return int32_t 账户序号，不存在时返回-1
+     */
+    int32_t Find(int64_t account) const;
+
+    /**
+     * @brief 查询账户序号，不存在时分配新序号
+     * @param account 资产账户，必须大于0
+     * @return int32_t 账户序号，账户非法或账本已满时返回-1
+     */
+    int32_t FindOrAdd(int64_t account);
+
+    /**
+     * @brief 按字符串形式的资产账户查询或分配序号
+     * @param fundAccount 资产账户
+     * @return int32_t 账户序号，账户不是数字或账本已满时返回-1
+     */
+    int32_t FindOrAdd(const char (&fundAccount)[32]) { return FindOrAdd(ParseFundAccount(fundAccount)); }
+
+    FundSlot& Slot(int32_t id) { return _slots[id]; }
+    const FundSlot& Slot(int32_t id) const { return _slots[id]; }
+
+    /**
+     * @brief 已分配的账户数
+     */
+    uint32_t Size() const;
+
+    uint32_t Capacity() const { return _capacity; }
+
+private:
+    struct Header;
+
+    uint32_t Hash(int64_t account) const;
+
+    /**
+     * @brief 读取索引项，遇到占位值时等待其他线程发布
+     */
+    uint32_t LoadIndex(uint32_t i) const;
+
+private:
+    std::string _path;                    // 文件路径
+    uint32_t _capacity;                   // 最大账户数
+    uint32_t _indexMask;                  // 索引长度-1，索引长度为2的幂
+    bool _preload;                        // 是否预加载
+    size_t _mapSize = 0;                  // 映射长度
+    uintptr_t _address = 0;               // 映射地址
+    Header* _header = nullptr;            // 文件头
+    FundSlot* _slots = nullptr;           // 资金槽位
+    std::atomic<uint32_t>* _index = nullptr;  // 账户索引，0表示空
+};
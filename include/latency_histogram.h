@@ -0,0 +1,82 @@
+/**
+ * @file latency_histogram.h
+ * @brief HDR风格的对数分桶延迟直方图，记录O(1)且不分配内存，误差不超过1%
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 延迟直方图
+ * 小于2^(SUB_BUCKET_BITS+1)的值每个值一个桶，更大的值按2的幂分段，每段再线性分为2^SUB_BUCKET_BITS个子桶，
+ * 桶宽与值的比例不超过1/2^SUB_BUCKET_BITS，覆盖int64全部正数范围。非线程安全，每个线程记录自己的直方图后合并。
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 7;                                    // 每段子桶数的位数，决定精度
+    static constexpr int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;                // 每段子桶数
+    static constexpr int BUCKET_COUNT = (64 - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;  // 总桶数
+
+    LatencyHistogram() { Reset(); }
+
+    /**
+     * @brief 记录一个值，负值按0记录（跨主机时钟偏差）
+     * @param value 值，如纳秒
+     */
+    void Record(int64_t value);
+
+    /**
+     * @brief 合并另一个直方图
+     * @param other 直方图
+     */
+    void Merge(const LatencyHistogram& other);
+
+    /**
+     * @brief 清空
+     */
+    void Reset();
+
+    int64_t GetCount() const { return _count; }
+    int64_t GetMin() const { return _count > 0 ? _min : 0; }
+    int64_t GetMax() const { return _max; }
+    double GetMean() const { return _count > 0 ? (double)_sum / _count : 0; }
+
+    /**
+     * @brief 获取百分位上的值
+     * @param percentile 百分位，0~100
+     * @return int64_t 该百分位所在桶的上界，不超过最大值；没有记录时返回0
+     */
+    int64_t ValueAtPercentile(double percentile) const;
+
+    /**
+     * @brief 按HdrHistogram的百分位分布格式（.hgrm）写出，可以直接用HdrHistogram的工具绘图对比
+     * 每行为: 值 百分位(0~1) 累计数 1/(1-百分位)，百分位从0开始每次向100%逼近一半距离，每一半距离5个刻度
+     * @param path 文件路径
+     * @param unitScale 输出值时除以的比例，如记录纳秒、输出微秒时为1000
+     * @return true 成功
+     * @return false 文件无法写入
+     */
+    bool WritePercentiles(const std::string& path, double unitScale) const;
+
+private:
+    static int BucketIndex(int64_t value);
+    static int64_t BucketUpper(int index);
+
+private:
+    int64_t _counts[BUCKET_COUNT];  // 每个桶的计数
+    int64_t _count;                 // 总数
+    int64_t _min;                   // 最小值
+    int64_t _max;                   // 最大值
+    int64_t _sum;                   // 总和，用于均值
+};
@@ -0,0 +1,184 @@
+/**
+ * @file matching_engine.h
+ * @brief 进程内撮合模拟，每只证券一个价格优先、时间优先的订单簿，成交结果回填到订单
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common_def.h"
+
+// 委托状态
+const char ENTRUST_STATUS_REPORTED = '2';  // 已报，未成交
+const char ENTRUST_STATUS_PARTIAL = '7';   // 部成
+const char ENTRUST_STATUS_FILLED = '8';    // 已成
+const char ENTRUST_STATUS_INVALID = '9';   // 废单
+
+// 一次成交
+struct Fill {
+    int32_t takerNo;  // 主动方委托编号
+    int32_t makerNo;  // 被动方委托编号
+    Price price;      // 成交价格，即被动方的委托价格
+    int32_t amount;   // 成交数量
+};
+
+/**
+ * @brief 成交回调，在订单簿锁内调用，不能再调用撮合引擎
+ */
+using FillHandler = std::function<void(const Fill& fill)>;
+
+/**
+ * @brief 单只证券的订单簿，非线程安全
+ * 价格档位按最小价格变动单位存放在平铺数组中，下标为(价格-跌停价)/最小变动单位；
+ * 同一档位的委托按到达顺序组成链表，链表节点来自订单簿自己的节点池，成交完的节点回收复用。
+ */
+class OrderBook {
+public:
+    static constexpr int64_t TICK_RAW = 100;  // 最小价格变动单位0.01，以Price的整数形式表示
+
+    /**
+     * @brief 构造函数，以参考价上下bandPercent作为价格范围
+     * @param refPrice 参考价，一般为首笔委托价格
+     * @param bandPercent 涨跌幅限制（百分比）
+     */
+    OrderBook(Price refPrice, int bandPercent = 20);
+
+    /**
+     * @brief 价格是否可以作为参考价：大于0且是最小变动单位的整数倍
+     */
+    static bool IsValidRefPrice(Price price) { return price.Raw() > 0 && price.Raw() % TICK_RAW == 0; }
+
+    /**
+     * @brief 撮合一笔委托，剩余数量挂入订单簿
+     * @param order 委托，成交后回填deal_price（成交均价）、deal_amount、entrust_status
+     * @param entrustNo 委托编号
+     * @param onFill 成交回调，可以为空
+     * @return true 成功
+     * @return false 废单：买卖方向、数量非法，价格不是最小变动单位的整数倍或超出涨跌幅
+     */
+    bool Match(Order& order, int32_t entrustNo, const FillHandler& onFill);
+
+    /**
+     * @brief 买一价，没有买单时为0
+     */
+    Price BestBid() const;
+
+    /**
+     * @brief 卖一价，没有卖单时为0
+     */
+    Price BestAsk() const;
+
+    /**
+     * @brief 某价位上挂单的总数量
+     * @param bs 买卖方向
+     * @param price 价格
+     * @return int64_t 挂单数量，价格非法时为0
+     */
+    int64_t LevelAmount(char bs, Price price) const;
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    // 挂单节点
+    struct Node {
+        uint32_t next;      // 同一档位的下一个节点
+        int32_t entrustNo;  // 委托编号
+        int32_t amount;     // 剩余数量
+    };
+
+    // 价格档位
+    struct Level {
+        uint32_t head = NIL;  // 最早的挂单
+        uint32_t tail = NIL;  // 最晚的挂单
+        int64_t amount = 0;   // 档位总数量
+    };
+
+    uint32_t AllocNode();
+    void FreeNode(uint32_t idx);
+
+    /**
+     * @brief 与对手方档位[best, limit]撮合
+     * @return int32_t 剩余数量
+     */
+    template <bool BUY>
+    int32_t Cross(int32_t tick, int32_t amount, int32_t entrustNo, Money& dealMoney, const FillHandler& onFill);
+
+    Price PriceOf(int32_t tick) const { return Price::FromRaw((_lowTick + tick) * TICK_RAW); }
+
+private:
+    int64_t _lowTick;                // 跌停价对应的tick
+    int32_t _levelCount;             // 档位数量
+    std::vector<Level> _bids;        // 买档位
+    std::vector<Level> _asks;        // 卖档位
+    int32_t _bestBid = -1;           // 买一档位下标，-1表示没有买单
+    int32_t _bestAsk;                // 卖一档位下标，_levelCount表示没有卖单
+    std::vector<Node> _nodes;        // 节点池
+    uint32_t _freeHead = NIL;        // 空闲节点链表
+};
+
+/**
+ * @brief 撮合引擎，按 交易所类别+证券代码 分配订单簿，订单簿在首笔价格合法的委托到达时以其价格为参考价创建，
+ * 价格为0或不在最小变动单位上的委托不会创建订单簿，作为废单返回
+ * 可以多线程调用，不同证券并行撮合，同一证券串行撮合
+ */
+class MatchingEngine {
+public:
+    /**
+     * @brief 构造函数
+     * @param onFill 成交回调，可以为空，同一证券的回调串行调用
+     */
+    explicit MatchingEngine(FillHandler onFill = nullptr);
+
+    /**
+     * @brief 撮合一笔委托，分配委托编号并回填成交字段
+     * @param order 委托
+     * @return true 成功
+     * @return false 废单，entrust_status为ENTRUST_STATUS_INVALID
+     */
+    bool Match(Order& order);
+
+    /**
+     * @brief 订单簿数量
+     */
+    size_t BookCount() const;
+
+private:
+    struct Book {
+        std::mutex mutex;  // 同一证券串行撮合
+        OrderBook book;
+
+        explicit Book(Price refPrice)
+            : book(refPrice) {
+        }
+    };
+
+    /**
+     * @brief 查找委托所属证券的订单簿，不存在时以委托价格为参考价创建
+     * @return Book* 订单簿，不存在且委托价格不能作为参考价时为空
+     */
+    Book* GetBook(const Order& order);
+
+private:
+    FillHandler _onFill;                                            // 成交回调
+    std::atomic<int32_t> _entrustNo{0};                             // 委托编号
+    mutable std::shared_mutex _mutex;                               // 保护_books
+    std::unordered_map<std::string, std::unique_ptr<Book>> _books;  // 交易所类别+证券代码 -> 订单簿
+};
@@ -0,0 +1,83 @@
+/**
+ * @file order_codec.h
+ * @brief 订单紧凑编码，带版本号的消息头，只编码非空字段，整数采用varint，字符串带长度前缀
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common_def.h"
+
+/**
+ * 编码格式（小端）：
+ * | magic(1字节) | version(1字节) | 字段位图(varint) | 按字段序号依次排列的非空字段 |
+ * 整数字段为zigzag varint，单字符字段为1字节，浮点字段为8字节，字符串字段为varint长度+内容（不含结尾0）。
+ * 版本2起价格/金额字段为定点数，按缩放后的整数编码为zigzag varint；版本1中为8字节double，解码时四舍五入转换。
+ * 版本3新增推送时间send_time（zigzag varint）。
+ * 字段序号一经发布不再改变，新增字段只能追加序号并提升版本号。
+ *
+ * 原始结构消息（-e raw）：| RAW_MAGIC(1字节) | version(1字节) | Order原始结构 |
+ * version为生成消息时的VERSION，Order布局的任何变化都必须提升VERSION；原始结构只能解码与当前布局相同版本的消息，
+ * 旧布局（版本1为double价格，版本2无send_time）及不带消息头的原始结构一律拒绝，不会按当前布局错误解释。
+ */
+class OrderCodec {
+public:
+    static constexpr uint8_t MAGIC = 0xA5;   // 消息头标识
+    static constexpr uint8_t VERSION = 3;    // 当前编码版本，解码兼容版本1、2
+    static constexpr uint8_t RAW_MAGIC = 0x5A;  // 原始结构消息头标识
+
+    // 原始结构消息的长度
+    static constexpr size_t RAW_MESSAGE_SIZE = 2 + sizeof(Order);
+
+    // 编码后的最大长度：每个字段的编码长度不超过其原始长度加5字节，另加消息头
+    static constexpr size_t MAX_ENCODED_SIZE = sizeof(Order) + 160;
+
+    /**
+     * @brief 将订单编码到调用方提供的缓冲区，不分配堆内存
+     * @param order 订单
+     * @param buf 输出缓冲区，建议长度为MAX_ENCODED_SIZE
+     * @param size 缓冲区长度
+     * @return size_t 编码后的长度，缓冲区不足时返回0
+     */
+    static size_t Encode(const Order& order, char* buf, size_t size);
+
+    /**
+     * @brief 解码订单，未出现的字段为默认值，不分配堆内存
+     * @param data 编码数据
+     * @param size 数据长度
+     * @param order 输出的订单
+     * @return true 成功
+     * @return false 数据不是合法的编码（消息头不符、版本过高、截断或字段越界）
+     */
+    static bool Decode(const char* data, size_t size, Order& order);
+
+    /**
+     * @brief 将订单按带版本消息头的原始结构写入缓冲区
+     * @param order 订单
+     * @param buf 输出缓冲区，长度至少为RAW_MESSAGE_SIZE
+     * @param size 缓冲区长度
+     * @return size_t 消息长度，缓冲区不足时返回0
+     */
+    static size_t EncodeRaw(const Order& order, char* buf, size_t size);
+
+    /**
+     * @brief 解码队列中的订单消息，紧凑编码或当前版本的原始结构
+     * @param data 消息数据
+     * @param size 消息长度
+     * @param order 输出的订单
+     * @return true 成功
+     * @return false 既不是合法编码也不是当前版本的原始结构
+     */
+    static bool DecodeMessage(const char* data, size_t size, Order& order);
+};
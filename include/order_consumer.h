@@ -0,0 +1,178 @@
+/**
+ * @file order_consumer.h
+ * @brief 订单消费引擎，阻塞监听全部订单队列，批量弹出后分发给工作线程池处理
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common_def.h"
+#include "latency_histogram.h"
+#include "order_sink.h"
+#include "queue_key_set.h"
+#include "redispp/redispp.h"
+
+// 消费参数
+struct ConsumerOptions {
+    int64_t queueCount = 1;                // 队列数量
+    std::string queueName = "order_queue"; // 订单队列名称前缀，队列为queue_name_i
+    int64_t popBatch = 100;                // 每次LPOP（Stream为每个队列XREADGROUP COUNT）最多弹出的订单数量
+    int64_t workers = 1;                   // 工作线程数
+    bool continuous = false;               // 是否持续消费，false-队列全部为空时退出
+    int64_t blockMs = 50;                  // 持续消费时BLPOP/XREADGROUP的阻塞时长（毫秒），会被限制在socket超时以内
+    int64_t pendingBatches = 64;           // 每个工作线程最多积压的批次数，超过时暂停拉取
+    bool stream = false;                   // 是否从Redis Stream消费（XREADGROUP/XACK），false-List（LPOP）
+    std::string group = "order_group";     // Stream消费组名称
+    std::string consumerName;              // Stream消费者名称，各消费进程必须不同，为空时使用 主机名_进程号
+    int64_t claimIdleMs = 30000;           // Stream中超过该时长（毫秒）未确认的订单由本消费者认领重新处理
+    std::string latencyPath;               // 端到端延迟百分位分布文件（.hgrm，微秒），为空时只输出摘要
+};
+
+/**
+ * @brief 订单处理回调，由工作线程调用，同一队列的订单始终在同一个工作线程中按入队顺序回调
+ * @param worker 工作线程序号
+ * @param queueIdx 订单所在的队列序号
+ * @param order 订单，回调中的修改（如成交回报字段）会写入输出端
+ */
+using OrderHandler = std::function<void(int64_t worker, int64_t queueIdx, Order& order)>;
+
+class OrderConsumer {
+public:
+    /**
+     * @brief 构造函数
+     * @param options 消费参数
+     * @param sinkFactory 输出端工厂，每个工作线程创建一个输出端，每处理完一个批次调用一次Flush
+     * @param handler 订单处理回调，在写入输出端之前调用，可以为空；同一进程内重新投递的未确认Stream消息不会重复调用
+     */
+    OrderConsumer(const ConsumerOptions& options, SinkFactory sinkFactory, OrderHandler handler = nullptr);
+
+    /**
+     * @brief 启动拉取线程（每个redis分片一个）和工作线程，直到队列为空（非持续模式）或调用Stop后返回，并输出统计信息
+     * @return true 成功
+     * @return false 拉取过程中出现redis异常（非持续模式）
+     */
+    bool Run();
+
+    /**
+     * @brief 停止消费，可以在信号处理函数中调用
+     */
+    void Stop() { _stop.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取已消费的订单总数
+     * @return int64_t 订单总数
+     */
+    int64_t GetConsumedCount() const { return _consumed.load(std::memory_order_relaxed); }
+
+private:
+    // 一次弹出的同一队列的订单
+    struct Batch {
+        int64_t queueIdx;                  // 队列序号
+        std::vector<std::string> elements; // 订单原始数据，Stream队列时与ids一一对应，没有订单字段的消息为空
+        std::vector<std::string> ids;      // Stream消息id，处理完后确认并删除，List队列为空
+        int node = 0;                      // 所在的redis分片，确认时使用
+        int64_t fetchTime = 0;             // 从redis取到的时间（Time::NowNano），与订单推送时间之差为队列延迟
+    };
+
+    // 工作线程的待处理批次
+    struct Worker {
+        std::mutex mtx;                // 批次队列锁
+        std::condition_variable cv;    // 批次到达/被取走通知
+        std::deque<Batch> batches;     // 待处理批次
+        bool done = false;             // 拉取线程已结束
+        int64_t orderCount = 0;        // 已处理订单数
+        int64_t badCount = 0;          // 无法解码、已移入死信队列的消息数
+        OrderSinkPtr sink;             // 输出端
+        LatencyHistogram latency;      // 端到端延迟（纳秒），只由本工作线程记录
+        std::unordered_map<std::string, Order> unacked; // 已执行处理回调但尚未确认的Stream消息（分片:队列:id）及处理后的订单，重新投递时直接使用，不重复冻结、撮合
+    };
+
+    /**
+     * @brief 拉取线程，从一个redis分片批量弹出订单并按队列分发给工作线程
+     * @param node redis分片序号
+     * @return true 成功
+     * @return false 出现redis异常
+     */
+    bool FetchLoop(int node);
+
+    /**
+     * @brief Stream拉取线程，先重新处理本消费者在该分片上未确认的订单，再读取新订单，并定期认领其他消费者超时未确认的订单
+     * @param node redis分片序号
+     * @return true 成功
+     * @return false 出现redis异常
+     */
+    bool FetchStreamLoop(int node);
+
+    /**
+     * @brief 解析XREADGROUP/XAUTOCLAIM返回的消息列表并追加到批次
+     * @param entries 消息列表，每个消息为[id, [field, value, ...]]
+     * @param batch 订单批次
+     * @return int64_t 消息数量
+     */
+    static int64_t ParseEntries(const redisReply& entries, Batch& batch);
+
+    /**
+     * @brief 认领全部队列中超时未确认的订单并分发
+     * @param redis redis连接
+     * @param node redis连接所属的分片序号
+     * @return int64_t 认领的订单数量
+     */
+    int64_t Reclaim(library::redis::RedisProxy& redis, int node);
+
+    /**
+     * @brief 确认并删除已处理的Stream消息，失败时留在待确认列表中，由超时认领重新处理
+     * @param batch 订单批次
+     * @return true 成功
+     * @return false 失败，消息仍待确认
+     */
+    bool Ack(const Batch& batch);
+
+    /**
+     * @brief 将无法解码的消息原样移入死信队列，Stream队列同时记录原消息id
+     * @param batch 订单批次
+     * @param bad 无法解码的消息在批次中的下标
+     * @return true 成功
+     * @return false redis异常，消息未移入死信队列
+     */
+    bool DeadLetter(const Batch& batch, const std::vector<size_t>& bad);
+
+    /**
+     * @brief 工作线程，按顺序处理分配给自己的批次
+     * @param idx 工作线程序号
+     */
+    void WorkLoop(int64_t idx);
+
+    /**
+     * @brief 将批次分发给负责该队列的工作线程，积压过多时等待
+     * @param batch 订单批次
+     */
+    void Dispatch(Batch&& batch);
+
+private:
+    ConsumerOptions _options;                      // 消费参数
+    SinkFactory _sinkFactory;                      // 输出端工厂
+    OrderHandler _handler;                         // 订单处理回调
+    QueueKeySet _queueKeys;                        // 全部队列的键
+    std::vector<std::unique_ptr<Worker>> _workers; // 工作线程
+    std::atomic<bool> _stop{false};                // 是否停止
+    std::atomic<int64_t> _consumed{0};             // 已消费的订单总数
+};
@@ -0,0 +1,96 @@
+/**
+ * @file order_producer.h
+ * @brief 订单生产者，按队列分片由多个线程并行向redis推送订单
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "latency_histogram.h"
+#include "order_workload.h"
+#include "queue_key_set.h"
+#include "rate_pacer.h"
+
+// 生产参数
+struct ProducerOptions {
+    int64_t accountCount = 1;                // 账户数量
+    int64_t orderCount = 10000;              // 订单数量
+    int64_t queueCount = 1;                  // 队列数量
+    std::string queueName = "order_queue";   // 订单队列名称前缀，队列为queue_name_i
+    int64_t batch = 0;                       // 每批推送的订单数量，0-逐笔推送
+    int64_t idBlock = 1000;                  // 订单编号每次预留的号段大小
+    int64_t threads = 1;                     // 生产线程数
+    bool compact = true;                     // 是否使用OrderCodec紧凑编码，false-推送带版本消息头的Order原始结构（OrderCodec::EncodeRaw）
+    int64_t asyncWindow = 0;                 // 异步推送时每个线程在途的RPUSH数量上限，0-同步推送
+    bool stream = false;                     // 是否推送到Redis Stream（XADD），false-List（RPUSH）
+    bool script = false;                     // 是否通过lua脚本在一次往返中分配编号、推送订单并累加账户订单数，仅支持List同步推送
+    PaceOptions pace;                        // 开环限速参数，rate为全部线程的总速率，按各线程的订单数分配
+    WorkloadProfile workload;                // 订单的账户、证券、买卖方向及数量分布
+};
+
+// 单个生产线程的统计
+struct ProducerStats {
+    int64_t queueCount = 0;       // 负责的队列数
+    int64_t orderCount = 0;       // 推送成功的订单数
+    double seconds = 0;           // 耗时（秒）
+    int64_t batchCount = 0;       // 批次数，批量模式有效
+    uint64_t minCycles = 0;       // 最小批次耗时（CPU时钟数）
+    uint64_t maxCycles = 0;       // 最大批次耗时（CPU时钟数）
+    uint64_t sumCycles = 0;       // 批次总耗时（CPU时钟数）
+    LatencyHistogram ackLatency;  // 限速时从计划发送时间到redis确认的延迟（纳秒），异步模式不统计
+    int64_t maxLagNs = 0;         // 限速时放行落后于计划时间的最大值（纳秒）
+    int64_t lateCount = 0;        // 限速时落后计划超过1毫秒放行的订单数
+    std::string error;            // 出错信息，为空表示成功
+};
+
+// 生产线程负责的一笔订单
+struct ShardOrder {
+    int64_t index;    // 订单序号
+    int64_t account;  // 账户序号，分配线程时由OrderWorkload::AccountIndex算出，推送时不再抽样
+};
+
+class OrderProducer {
+public:
+    /**
+     * @brief 构造函数
+     * @param options 生产参数
+     */
+    OrderProducer(const ProducerOptions& options);
+
+    /**
+     * @brief 启动生产线程推送全部订单，等待结束后输出每个线程及汇总的吞吐量
+     * 第i笔订单由OrderWorkload生成，按(fundAccount + 账户序号) % queueCount分配队列，队列q由线程q % threads负责，
+     * 因此各线程操作的队列互不重叠，且各自从连接池获取独立的连接；
+     * 配置了多个redis分片时，订单再按资产账户一致性哈希到分片，同一队列名在每个分片上各有一个
+     * @return true 全部成功
+     * @return false 存在失败的线程
+     */
+    bool Run();
+
+private:
+    /**
+     * @brief 单个生产线程，推送属于分片shard的全部订单
+     * @param shard 分片序号（线程序号）
+     * @param shardCount 分片总数
+     * @param orders 本线程负责的订单，按序号升序
+     * @param stats 输出的统计信息
+     */
+    void RunShard(int64_t shard, int64_t shardCount, const std::vector<ShardOrder>& orders, ProducerStats& stats);
+
+private:
+    ProducerOptions _options;  // 生产参数
+    QueueKeySet _queueKeys;    // 全部队列的键，按队列序号预先生成
+    OrderWorkload _workload;   // 订单生成器，各线程共用
+};
@@ -0,0 +1,129 @@
+/**
+ * @file order_sink.h
+ * @brief 消费订单的输出端，支持丢弃、CSV文件、二进制追加文件，数据先写入缓冲区，在批次边界统一写出
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "common_def.h"
+#include "fmt/format.h"
+
+class OrderSink {
+public:
+    virtual ~OrderSink() {}
+
+    /**
+     * @brief 写入一笔订单（只写入缓冲区）
+     * @param order 订单
+     */
+    virtual void Write(const Order& order) = 0;
+
+    /**
+     * @brief 批次边界，缓冲区超过阈值时写出
+     * @return true 成功或无需写出
+     * @return false 写出失败，错误信息通过GetError获取
+     */
+    virtual bool FlushIfFull() { return true; }
+
+    /**
+     * @brief 写出缓冲区中的全部数据
+     * @return true 成功
+     * @return false 写出失败，错误信息通过GetError获取
+     */
+    virtual bool Flush() { return true; }
+
+    /**
+     * @brief 获取最近一次写出失败的原因
+     */
+    const std::string& GetError() const { return _error; }
+
+protected:
+    std::string _error;  // 最近一次写出失败的原因
+};
+
+using OrderSinkPtr = std::shared_ptr<OrderSink>;
+
+/**
+ * @brief 创建输出端的工厂，每个消费工作线程调用一次，输出端只在所属线程中使用，无需加锁
+ * @param worker 工作线程序号
+ */
+using SinkFactory = std::function<OrderSinkPtr(int64_t worker)>;
+
+// 丢弃全部订单，用于测试消费吞吐量
+class NullSink : public OrderSink {
+public:
+    void Write(const Order&) override {}
+};
+
+// 带缓冲区的文件输出端基类
+class BufferedFileSink : public OrderSink {
+public:
+    /**
+     * @brief 构造函数，以追加方式打开文件，失败时抛出library::utils::Exception
+     * @param path 文件路径
+     * @param bufferSize 缓冲区超过该大小时在批次边界写出
+     */
+    BufferedFileSink(const std::string& path, size_t bufferSize);
+    ~BufferedFileSink();
+
+    bool FlushIfFull() override;
+
+    /**
+     * @brief 写出缓冲区中的全部数据，被信号中断时重试；失败时丢弃未写出的部分，已写出的部分保留在文件中
+     */
+    bool Flush() override;
+
+protected:
+    /**
+     * @brief 文件是否为新建（长度为0），用于决定是否写表头
+     */
+    bool IsEmptyFile() const { return _emptyFile; }
+
+protected:
+    fmt::memory_buffer _buffer;  // 写缓冲区
+
+private:
+    std::string _path;          // 文件路径
+    int _fd = -1;               // 文件描述符
+    size_t _bufferSize;         // 写出阈值
+    bool _emptyFile = false;    // 打开时文件是否为空
+};
+
+// CSV格式输出
+class CsvSink : public BufferedFileSink {
+public:
+    CsvSink(const std::string& path, size_t bufferSize);
+
+    void Write(const Order& order) override;
+};
+
+// 按Order原始结构追加写入的二进制文件，可直接按sizeof(Order)读回
+class BinarySink : public BufferedFileSink {
+public:
+    BinarySink(const std::string& path, size_t bufferSize);
+
+    void Write(const Order& order) override;
+};
+
+/**
+ * @brief 根据类型创建输出端工厂
+ * @param type 类型：null、csv、binary
+ * @param pathPrefix 文件路径前缀，每个工作线程写入 pathPrefix_worker.csv/.bin
+ * @param bufferSize 缓冲区写出阈值
+ * @return SinkFactory 输出端工厂，类型不支持时为空
+ */
+SinkFactory MakeSinkFactory(const std::string& type, const std::string& pathPrefix, size_t bufferSize);
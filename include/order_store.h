@@ -0,0 +1,112 @@
+/**
+ * @file order_store.h
+ * @brief 订单冷热分离存储，撮合/风控扫描只访问64字节对齐的热数据
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common_def.h"
+
+// 订单热数据，恰好占一个缓存行，处理一笔订单只访问一个缓存行
+struct alignas(64) OrderCore {
+    int64_t account = 0;         // 资产账户的数值形式，fund_account不是数字时为0
+    Price entrust_price;         // 委托价格
+    Price deal_price;            // 成交价格
+    Money freeze_money;          // 冻结资金
+    double deal_amount = 0;      // 成交数量
+    double cancel_amount = 0;    // 撤销数量
+    int32_t entrust_amount = 0;  // 委托数量
+    int32_t entrust_time = 0;    // 委托时间
+    int32_t update_time = 0;     // 委托更新时间
+    char exchange_type = 0;      // 交易所类别
+    char entrust_bs = 0;         // 买卖方向
+    char entrust_prop = 0;       // 委托属性
+    char entrust_status = 0;     // 委托状态
+};
+
+static_assert(sizeof(OrderCore) == 64, "OrderCore must fit in one cache line");
+
+// 订单冷数据，只在接收、落地和回报时访问
+struct OrderCold {
+    int32_t branch_no = 0;         // 操作分支机构
+    char client_id[32] = {};       // 客户编号
+    char fund_account[32] = {};    // 资产账户
+    char password[32] = {};        // 密码
+    char order_id[16] = {};        // 客户订单编号
+    int32_t batch_no = 0;          // 委托批号
+    char stock_account[32] = {};   // 证券账号
+    char stock_code[32] = {};      // 证券代码
+    char op_entrust_way = 0;       // 委托方式
+    Money entrust_money;           // 委托金额
+    char registe_sure_flag = 0;    // 是否已签署确认书
+    int32_t init_date = 0;         // 交易日期
+    int32_t entrust_no = 0;        // 委托编号
+    int32_t report_no = 0;         // 申请编号
+    char seat_no[6] = {};          // 席位编号
+    Money fees;                    // 总费用
+    char remark[256] = {};         // 提示说明
+    int64_t send_time = 0;         // 推送时间（纳秒）
+};
+
+/**
+ * @brief 订单存储，订单按加入顺序分配连续的下标，热数据和冷数据分别保存在两个按下标索引的数组中
+ * 非线程安全，每个线程使用自己的存储
+ */
+class OrderStore {
+public:
+    /**
+     * @brief 预留容量
+     * @param count 订单数量
+     */
+    void Reserve(size_t count);
+
+    /**
+     * @brief 加入一笔订单
+     * @param order 订单
+     * @return uint32_t 订单下标
+     */
+    uint32_t Add(const Order& order);
+
+    /**
+     * @brief 将订单还原为Order结构
+     * @param index 订单下标
+     * @param order 输出的订单
+     */
+    void Load(uint32_t index, Order& order) const;
+
+    /**
+     * @brief 用订单整体覆盖指定下标的热数据和冷数据
+     * @param index 订单下标
+     * @param order 订单
+     */
+    void Store(uint32_t index, const Order& order);
+
+    OrderCore& Core(uint32_t index) { return _cores[index]; }
+    const OrderCore& Core(uint32_t index) const { return _cores[index]; }
+    OrderCold& Cold(uint32_t index) { return _colds[index]; }
+    const OrderCold& Cold(uint32_t index) const { return _colds[index]; }
+
+    /**
+     * @brief 全部热数据，用于顺序扫描
+     */
+    const std::vector<OrderCore>& Cores() const { return _cores; }
+
+    size_t Size() const { return _cores.size(); }
+    void Clear();
+
+private:
+    std::vector<OrderCore> _cores;  // 热数据，按下标连续存放
+    std::vector<OrderCold> _colds;  // 冷数据，与热数据下标一一对应
+};
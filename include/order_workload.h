@@ -0,0 +1,132 @@
+/**
+ * @file order_workload.h
+ * @brief 测试订单生成器，按配置的账户、证券、买卖方向及数量分布生成订单，使热点账户争用和缓存行为接近生产
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common_def.h"
+
+// 证券配置
+struct SymbolProfile {
+    std::string code;          // 证券代码
+    char exchangeType = '1';   // 交易所类别
+    Price refPrice;            // 参考价
+    int bandPercent = 0;       // 委托价格在参考价上下的范围（百分比），0-固定为参考价
+    double weight = 0;         // 被选中的相对权重，0-按symbolSkew由排名决定
+};
+
+// 订单分布配置，默认值与原来的固定测试订单一致：账户轮流、同一账户买卖交替、600028 4.26元 300股
+struct WorkloadProfile {
+    uint64_t seed = 1;                  // 随机种子，相同种子和序号生成相同的订单
+    double accountSkew = 0;             // 账户选择的Zipf指数，0-按序号轮流
+    double buyRatio = -1;               // 买入委托的比例，小于0-同一账户买卖交替
+    int64_t lot = 100;                  // 每手股数
+    int64_t minLots = 3;                // 最少手数
+    int64_t maxLots = 3;                // 最多手数
+    double amountSkew = 0;              // 手数的Zipf指数，手数越少越常见，0-均匀分布
+    double symbolSkew = 0;              // 未指定权重的证券按排名的Zipf指数，0-等权
+    std::vector<SymbolProfile> symbols; // 证券池，为空时只有600028
+};
+
+/**
+ * @brief Zipf分布抽样（rejection-inversion，Hörmann & Derflinger 1996），不需要按元素数预计算累积分布，
+ * 每次抽样期望不到两个均匀随机数，适合上百万账户
+ */
+class ZipfSampler {
+public:
+    /**
+     * @brief 构造函数
+     * @param count 元素数量，至少为1
+     * @param exponent Zipf指数，必须大于0
+     */
+    ZipfSampler(int64_t count, double exponent);
+
+    /**
+     * @brief 抽样
+     * @param state 随机数状态，每次消耗一个或多个随机数
+     * @return int64_t 排名，1~count，排名1概率最大
+     */
+    int64_t Sample(uint64_t& state) const;
+
+private:
+    double H(double x) const;
+    double HIntegral(double x) const;
+    double HIntegralInverse(double x) const;
+
+private:
+    int64_t _count;
+    double _exponent;
+    double _hIntegralX1;
+    double _hIntegralN;
+    double _s;
+};
+
+/**
+ * @brief 订单生成器
+ * 第i笔订单的全部随机字段只由种子和i决定，多个生产线程各自按i生成时结果一致，线程按账户所在队列筛选订单时无需通信。
+ * 构造后只读，可以多线程共用。
+ */
+class OrderWorkload {
+public:
+    /**
+     * @brief 构造函数
+     * @param profile 分布配置
+     * @param accountCount 账户数量，账户为FUND_ACCOUNT_BASE起连续的accountCount个
+     */
+    OrderWorkload(const WorkloadProfile& profile, int64_t accountCount);
+
+    /**
+     * @brief 从JSON文件读取分布配置，缺少的项使用默认值，失败时抛出library::utils::Exception
+     * @param path 文件路径
+     * @return WorkloadProfile 分布配置
+     */
+    static WorkloadProfile LoadProfile(const std::string& path);
+
+    /**
+     * @brief 第i笔订单的账户序号，资产账户为FUND_ACCOUNT_BASE+序号
+     * @param i 订单序号
+     * @return int64_t 账户序号，0~accountCount-1
+     */
+    int64_t AccountIndex(int64_t i) const;
+
+    /**
+     * @brief 填写第i笔订单的客户编号、资产账户、证券、买卖方向、数量和价格，其他字段保持不变
+     * @param i 订单序号
+     * @param order 订单
+     */
+    void Fill(int64_t i, Order& order) const { Fill(i, AccountIndex(i), order); }
+
+    /**
+     * @brief 同Fill(i, order)，账户序号由调用方预先用AccountIndex(i)算出，避免重复抽样
+     * @param i 订单序号
+     * @param account 账户序号，必须等于AccountIndex(i)
+     * @param order 订单
+     */
+    void Fill(int64_t i, int64_t account, Order& order) const;
+
+    int64_t GetAccountCount() const { return _accountCount; }
+    const std::vector<SymbolProfile>& GetSymbols() const { return _profile.symbols; }
+
+private:
+    WorkloadProfile _profile;                   // 分布配置
+    int64_t _accountCount;                      // 账户数量
+    int64_t _accountStride;                     // 排名到账户序号的乘数，与账户数互质，热点账户分散到各队列
+    std::unique_ptr<ZipfSampler> _accountZipf;  // 账户抽样，accountSkew为0时为空
+    std::unique_ptr<ZipfSampler> _lotZipf;      // 手数抽样，amountSkew为0时为空
+    std::vector<double> _symbolWeights;         // 证券的累积权重
+};
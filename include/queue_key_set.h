@@ -0,0 +1,70 @@
+/**
+ * @file queue_key_set.h
+ * @brief 订单队列的键表，构造时一次生成全部队列的键，热路径上按队列序号取用，不再逐笔格式化和分配内存
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sw/redis++/redis++.h"
+
+class QueueKeySet {
+public:
+    /**
+     * @brief 构造函数，生成queue_name_0 ... queue_name_{queueCount-1}
+     * @param queueName 队列名称前缀
+     * @param queueCount 队列数量，至少为1
+     */
+    QueueKeySet(const std::string& queueName, int64_t queueCount);
+
+    /**
+     * @brief 获取队列数量
+     * @return int64_t 队列数量
+     */
+    int64_t Size() const { return (int64_t)_keys.size(); }
+
+    /**
+     * @brief 获取队列的键，指向键表内部，键表存在期间有效
+     * @param idx 队列序号，调用方保证合法
+     * @return sw::redis::StringView 队列的键
+     */
+    sw::redis::StringView Get(int64_t idx) const { return sw::redis::StringView(_keys[idx].data(), _keys[idx].size()); }
+
+    /**
+     * @brief 获取队列的键
+     * @param idx 队列序号，调用方保证合法
+     * @return const std::string& 队列的键
+     */
+    const std::string& operator[](int64_t idx) const { return _keys[idx]; }
+
+    /**
+     * @brief 全部队列的键，按队列序号排列，用于拼接多键命令的参数
+     */
+    std::vector<std::string>::const_iterator begin() const { return _keys.begin(); }
+    std::vector<std::string>::const_iterator end() const { return _keys.end(); }
+
+    /**
+     * @brief 由redis回复中的键解析队列序号，不分配内存
+     * @param data 键
+     * @param size 键的长度
+     * @return int64_t 队列序号，不是本键表中的键时返回-1
+     */
+    int64_t IndexOf(const char* data, size_t size) const;
+
+private:
+    std::string _prefix;             // 键的前缀，queue_name_
+    std::vector<std::string> _keys;  // 全部队列的键，下标为队列序号
+};
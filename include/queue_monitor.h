@@ -0,0 +1,68 @@
+/**
+ * @file queue_monitor.h
+ * @brief 队列积压监控，通过从库查询各分片上订单队列的长度，不占用主库处理订单的CPU
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "queue_key_set.h"
+
+// 监控参数
+struct MonitorOptions {
+    int64_t queueCount = 1;                // 队列数量
+    std::string queueName = "order_queue"; // 订单队列名称前缀，队列为queue_name_i
+    bool stream = false;                   // 是否为Redis Stream队列，是时同时查询消费组待确认的订单数
+    std::string group = "order_group";     // Stream消费组名称
+    bool continuous = false;               // 是否持续刷新直到调用Stop，false-只查询一次
+    int64_t intervalMs = 1000;             // 持续刷新的间隔（毫秒）
+};
+
+class QueueMonitor {
+public:
+    /**
+     * @brief 构造函数
+     * @param options 监控参数
+     */
+    QueueMonitor(const MonitorOptions& options);
+
+    /**
+     * @brief 查询全部分片上每个队列的积压订单数并输出，持续模式下定时刷新直到调用Stop
+     * 查询通过从库连接（RedisRole::Replica）执行，每个分片每次刷新一次往返；从库的复制延迟会体现为积压数略有滞后
+     * @return true 成功
+     * @return false 查询出现redis异常（非持续模式）
+     */
+    bool Run();
+
+    /**
+     * @brief 停止刷新，可以在信号处理函数中调用
+     */
+    void Stop() { _stop.store(true, std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief 通过一个pipeline查询一个分片上的全部队列
+     * @param node redis分片序号
+     * @param depths 输出每个队列的长度
+     * @param pending 输出每个队列消费组待确认的订单数，List队列或消费组不存在时为-1
+     */
+    void Query(int node, std::vector<int64_t>& depths, std::vector<int64_t>& pending);
+
+private:
+    MonitorOptions _options;        // 监控参数
+    QueueKeySet _queueKeys;         // 全部队列的键
+    std::atomic<bool> _stop{false}; // 是否停止
+};
@@ -0,0 +1,96 @@
+/**
+ * @file rate_pacer.h
+ * @brief 开环定速发送的节拍器，按计划时间表放行订单，不受服务端响应快慢影响
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+
+// 节拍参数
+struct PaceOptions {
+    double rate = 0;           // 目标速率（笔/秒），0-不限速
+    int64_t burst = 1;         // 每次同时放行的订单数，计划时间相同，平均速率不变
+    double rampSeconds = 0;    // 速率从0线性增加到rate所用的秒数，0-从开始即为rate
+};
+
+/**
+ * @brief 节拍器
+ * 第k笔订单的计划时间由k直接算出（恒定速率为k/rate，爬坡段为sqrt(2*ramp*k/rate)），不累积误差；
+ * 发送落后于计划时不补偿也不丢弃，后续订单仍按原计划时间计算延迟，避免协调遗漏（coordinated omission）。
+ * 以Time::Rdtsc计时，距计划时间较远时先睡眠再自旋。非线程安全，每个生产线程一个。
+ */
+class RatePacer {
+public:
+    /**
+     * @brief 构造函数
+     * @param options 节拍参数，rate为本节拍器的速率
+     */
+    explicit RatePacer(const PaceOptions& options);
+
+    /**
+     * @brief 以当前时间作为时间表起点
+     */
+    void Start();
+
+    /**
+     * @brief 是否限速
+     */
+    bool Enabled() const { return _options.rate > 0; }
+
+    /**
+     * @brief 下一笔订单的计划时间是否已到
+     * @return true 已到，调用Wait不会等待
+     */
+    bool Due() const;
+
+    /**
+     * @brief 等待到下一笔订单的计划时间
+     * @return int64_t 计划时间（与Time::NowNano同一时钟的纳秒），延迟应从该时间开始计算
+     */
+    int64_t Wait();
+
+    /**
+     * @brief 获取已放行的订单数
+     */
+    int64_t GetCount() const { return _next; }
+
+    /**
+     * @brief 获取放行时落后于计划时间的最大值（纳秒），持续增大说明已达到饱和
+     */
+    int64_t GetMaxLagNs() const { return _maxLagNs; }
+
+    /**
+     * @brief 获取放行时已落后于计划时间超过1毫秒的订单数
+     */
+    int64_t GetLateCount() const { return _lateCount; }
+
+private:
+    /**
+     * @brief 第k笔订单相对起点的计划时间（秒）
+     */
+    double ScheduleSeconds(int64_t k) const;
+
+    /**
+     * @brief 下一笔订单的计划时间（CPU时钟数）
+     */
+    uint64_t NextCycles() const;
+
+private:
+    PaceOptions _options;          // 节拍参数
+    double _cyclesPerSec = 0;      // 每秒CPU时钟数
+    uint64_t _startCycles = 0;     // 起点（CPU时钟数）
+    int64_t _startNano = 0;        // 起点（Time::NowNano）
+    int64_t _next = 0;             // 下一笔订单的序号
+    int64_t _maxLagNs = 0;         // 最大落后时间（纳秒）
+    int64_t _lateCount = 0;        // 落后超过1毫秒的订单数
+};
@@ -0,0 +1,95 @@
+/**
+ * @file redis_stand_in.h
+ * @brief Redis替身服务，在本机实现本项目用到的哨兵和主从库命令子集，不依赖真实redis测量客户端吞吐
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 替身服务参数
+struct StandInOptions {
+    std::string host = "127.0.0.1";    // 监听地址，哨兵返回的主从库地址也使用该地址
+    std::vector<int> sentinelPorts{0}; // 哨兵端口，0-由系统分配
+    int masterPort = 0;                // 主库端口，0-由系统分配
+    int replicaPort = 0;               // 从库端口，0-由系统分配
+    int64_t latencyUs = 0;             // 主从库每次读到请求后延迟回复的微秒数，模拟网络往返，0-不延迟
+};
+
+/**
+ * @brief Redis替身服务
+ * 一组哨兵、主库和从库监听同一份内存数据，从库没有复制延迟，对写命令返回READONLY。
+ * 哨兵对任意主库名称都返回本服务的主从库地址，redis++和AsyncRedis按哨兵模式正常连接。
+ * 支持的命令: PING AUTH SELECT INFO ROLE CLIENT SENTINEL GET DEL FLUSHDB FLUSHALL INCR INCRBY
+ * RPUSH LPOP BLPOP LLEN XADD XLEN XGROUP(CREATE) XREADGROUP XACK XDEL XPENDING(汇总) XAUTOCLAIM，
+ * 其余命令返回unknown command错误。
+ * 每个连接一个线程，全部数据由一把锁保护，吞吐远低于真实redis，只用于隔离测量客户端和复现问题。
+ */
+class RedisStandIn {
+public:
+    /**
+     * @brief 构造函数
+     * @param options 替身服务参数
+     */
+    explicit RedisStandIn(const StandInOptions& options);
+    ~RedisStandIn();
+
+    RedisStandIn(const RedisStandIn&) = delete;
+    RedisStandIn& operator=(const RedisStandIn&) = delete;
+
+    /**
+     * @brief 监听全部端口并启动接收线程，失败时抛出library::utils::Exception
+     */
+    void Start();
+
+    /**
+     * @brief 关闭监听和全部连接，等待线程退出，析构时自动调用
+     */
+    void Stop();
+
+    /**
+     * @brief 获取监听地址
+     * @return const std::string& 监听地址
+     */
+    const std::string& GetHost() const;
+
+    /**
+     * @brief 获取实际监听的哨兵端口，Start后有效
+     * @return std::vector<int> 哨兵端口
+     */
+    std::vector<int> GetSentinelPorts() const;
+
+    /**
+     * @brief 获取实际监听的主库端口，Start后有效
+     * @return int 主库端口
+     */
+    int GetMasterPort() const;
+
+    /**
+     * @brief 获取实际监听的从库端口，Start后有效
+     * @return int 从库端口
+     */
+    int GetReplicaPort() const;
+
+    /**
+     * @brief 获取主从库已执行的命令数
+     * @return int64_t 命令数
+     */
+    int64_t GetCommandCount() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> _impl;  // 实现
+};
@@ -0,0 +1,114 @@
+/**
+ * @file async_redis.h
+ * @brief 基于hiredis异步接口和epoll事件循环的非阻塞redis客户端
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "redispp/redispp.h"
+#include "redispp/redispp_export.h"
+
+namespace library
+{
+    namespace redis
+    {
+        // 异步命令的回复
+        struct AsyncReply
+        {
+            bool ok = false;                   // 是否成功，连接断开、超时或redis返回错误时为false
+            std::string error;                 // 失败原因
+            bool nil = false;                  // 是否为空回复
+            long long integer = 0;             // 整数回复
+            std::string str;                   // 字符串或状态回复
+            std::vector<std::string> elements; // 数组回复的元素，整数元素转为字符串，空元素为空字符串
+        };
+
+        /**
+         * @brief 异步命令的回调，在事件循环线程中调用，不能阻塞
+         * @param reply 回复
+         */
+        using AsyncCallback = std::function<void(AsyncReply &reply)>;
+
+        /**
+         * @brief 异步redis客户端
+         * 每个客户端一个事件循环线程和一条连接，任意线程提交的命令先放入提交队列，由事件循环线程批量写入连接，
+         * 同一客户端的命令按提交顺序执行。连接通过哨兵查找主库（或从库），断开后重新查找并重连，
+         * 断开时已发出的命令以失败回调，未连接期间提交的命令等待下一次连接，连接失败时以失败回调。
+         */
+        class REDISPP_EXPORT AsyncRedis
+        {
+        public:
+            AsyncRedis();
+            ~AsyncRedis();
+
+            AsyncRedis(const AsyncRedis &) = delete;
+            AsyncRedis &operator=(const AsyncRedis &) = delete;
+
+            /**
+             * @brief 使用Redispp::Init的哨兵和连接配置启动，失败时抛出library::utils::Exception
+             * @param db 数据库实例id，如果为-1则读取配置文件中的db
+             */
+            void Start(int db = -1);
+
+            /**
+             * @brief 通过哨兵查找redis并启动事件循环，所有哨兵均不可用时抛出library::utils::Exception
+             * @param sentinelConfigs 哨兵配置
+             * @param redisConfig redis连接配置，socketTimeout同时作为命令超时
+             * @param db 数据库实例id，如果为-1则读取配置中的db
+             */
+            void Start(const SentinelConfigArray &sentinelConfigs, const RedisConfigPtr &redisConfig, int db = -1);
+
+            /**
+             * @brief 停止事件循环，尚未完成的命令以失败回调
+             */
+            void Stop();
+
+            /**
+             * @brief 提交命令，在调用线程中完成编码，不等待结果
+             * @param args 命令及参数，如{"RPUSH", key, value}，调用返回后即可释放
+             * @param callback 回调，可以为空
+             */
+            void Command(std::initializer_list<sw::redis::StringView> args, AsyncCallback callback);
+
+            /**
+             * @brief 提交命令
+             * @param args 命令及参数
+             * @param callback 回调，可以为空
+             */
+            void Command(const std::vector<sw::redis::StringView> &args, AsyncCallback callback);
+
+            /**
+             * @brief 提交命令，通过future获取结果
+             * @param args 命令及参数
+             * @return std::future<AsyncReply> 回复
+             */
+            std::future<AsyncReply> Command(std::initializer_list<sw::redis::StringView> args);
+
+            /**
+             * @brief 已提交但尚未回调的命令数
+             */
+            int64_t GetInflight() const;
+
+        private:
+            struct Impl;
+            std::unique_ptr<Impl> _impl;
+        };
+    } // namespace redis
+} // namespace library
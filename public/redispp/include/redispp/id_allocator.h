@@ -0,0 +1,119 @@
+/**
+ * @file id_allocator.h
+ * @brief 号段式编号分配器，通过INCRBY一次预留一段编号，本地无锁分配
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "redispp/redispp_export.h"
+
+namespace library
+{
+    namespace redis
+    {
+        /**
+         * @brief 号段式编号分配器
+         * 每次通过一条INCRBY key blockSize从redis预留一段连续编号，在本地逐个分配；
+         * 当前号段用掉一半时由后台线程预取下一段，号段切换时通常无需等待网络。
+         * 一个实例只能由一个线程调用Next，多线程生产时每个线程各自持有一个实例即可，编号全局不重复。
+         * 进程退出时当前号段中未用完的编号会被丢弃，因此编号唯一递增但不保证连续。
+         */
+        class REDISPP_EXPORT IdAllocator
+        {
+        public:
+            /**
+             * @brief 构造函数，启动后台预取线程，第一段编号在首次调用Next时获取
+             * @param key 计数器的redis键
+             * @param blockSize 每次预留的编号数量
+             * @param db 数据库实例id，如果为-1则读取配置文件中的db
+             */
+            IdAllocator(const std::string &key, int64_t blockSize, int db = -1);
+
+            /**
+             * @brief 析构函数，停止后台预取线程
+             */
+            ~IdAllocator();
+
+            IdAllocator(const IdAllocator &) = delete;
+            IdAllocator &operator=(const IdAllocator &) = delete;
+
+            /**
+             * @brief 分配下一个编号，号段用尽且预取失败时抛出sw::redis::Error
+             * @return int64_t 编号
+             */
+            int64_t Next()
+            {
+                if (_cur == _end)
+                {
+                    SwitchBlock();
+                }
+
+                int64_t id = _cur++;
+                if (_cur == _prefetchMark)
+                {
+                    RequestPrefetch();
+                }
+                return id;
+            }
+
+            /**
+             * @brief 获取号段大小
+             * @return int64_t 号段大小
+             */
+            int64_t GetBlockSize() const { return _blockSize; }
+
+        private:
+            /**
+             * @brief 切换到预取好的号段，若尚未到达则等待
+             */
+            void SwitchBlock();
+
+            /**
+             * @brief 通知后台线程预取下一个号段
+             */
+            void RequestPrefetch();
+
+            /**
+             * @brief 后台预取线程
+             */
+            void PrefetchLoop();
+
+        private:
+            std::string _key;   // 计数器的redis键
+            int64_t _blockSize; // 号段大小
+            int _db;            // 数据库实例号
+
+            // 以下字段只由调用Next的线程访问
+            int64_t _cur = 0;          // 下一个待分配的编号
+            int64_t _end = 0;          // 当前号段的结束编号（不含）
+            int64_t _prefetchMark = 0; // 分配到该编号时触发预取
+            bool _pending = false;     // 是否已发起下一号段的预取
+
+            std::atomic<int64_t> _nextStart{0}; // 预取到的号段起始编号，0表示尚未就绪
+            std::atomic<bool> _failed{false};   // 预取是否失败
+            std::exception_ptr _error;          // 预取失败的异常，_failed为true时有效
+            std::mutex _mtx;                    // 预取请求锁，每个号段只触发一次
+            std::condition_variable _cv;        // 预取请求通知
+            bool _requested = false;            // 是否有待处理的预取请求
+            bool _stop = false;                 // 是否停止后台线程
+            std::thread _worker;                // 后台预取线程
+        };
+    } // namespace redis
+} // namespace library
@@ -0,0 +1,92 @@
+/**
+ * @file redis_shards.h
+ * @brief 多组哨兵/主库的客户端分片，按一致性哈希路由
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "redispp/redispp.h"
+#include "redispp/redispp_export.h"
+#include "utils/singleton.h"
+
+namespace library
+{
+    namespace redis
+    {
+        // 分片配置，每个分片为一组哨兵监控的一个主库
+        struct ShardConfig
+        {
+            std::string name;                    // 分片名称，决定分片在哈希环上的位置，为空时使用主库名称
+            SentinelConfigArray sentinelConfigs; // 哨兵配置
+            RedisConfigPtr redisConfig;          // redis连接配置
+        };
+        using ShardConfigArray = std::vector<ShardConfig>;
+
+        /**
+         * @brief 客户端分片
+         * 每个分片一个独立的Redispp连接池，第一个分片就是Redispp::Instance()，不区分分片的代码（如订单编号计数器）继续使用第一个分片。
+         * 路由键通过一致性哈希映射到分片，每个分片在哈希环上有VIRTUAL_NODES个由分片名称生成的虚拟节点，
+         * 路由只取决于分片名称，不同进程对同一路由键得到相同的分片；增加或删除分片时只有约1/N的路由键改变位置。
+         * 未调用Init时只有第一个分片。
+         */
+        class REDISPP_EXPORT RedisShards : public library::utils::Singleton<RedisShards>
+        {
+        public:
+            static constexpr int VIRTUAL_NODES = 160; // 每个分片的虚拟节点数
+
+            /**
+             * @brief 初始化各分片的连接池和哈希环，进程启动时调用一次，分片名称重复时抛出library::utils::Exception
+             * @param configs 各分片的配置，至少一个
+             */
+            void Init(const ShardConfigArray &configs);
+
+            /**
+             * @brief 获取分片数量
+             * @return int 分片数量，未初始化时为1
+             */
+            int GetShardCount() const { return _shards.empty() ? 1 : (int)_shards.size(); }
+
+            /**
+             * @brief 获取分片的连接池
+             * @param idx 分片序号，调用方保证合法
+             * @return Redispp& 连接池
+             */
+            Redispp &GetShard(int idx) const { return _shards.empty() ? *Redispp::Instance() : *_shards[idx]; }
+
+            /**
+             * @brief 获取分片名称
+             * @param idx 分片序号，调用方保证合法
+             * @return const std::string& 分片名称，未初始化时为空
+             */
+            const std::string &GetShardName(int idx) const;
+
+            /**
+             * @brief 按一致性哈希查找路由键所在的分片
+             * @param routeKey 路由键
+             * @return int 分片序号
+             */
+            int Locate(const sw::redis::StringView &routeKey) const;
+
+        private:
+            std::vector<Redispp *> _shards;                // 各分片的连接池，第一个为Redispp::Instance()
+            std::vector<std::unique_ptr<Redispp>> _owned;  // 第二个起的分片的连接池
+            std::vector<std::string> _names;               // 各分片的名称
+            std::vector<std::pair<uint64_t, int>> _ring;   // 哈希环，按哈希值排序的(虚拟节点哈希值, 分片序号)
+        };
+    } // namespace redis
+} // namespace library
@@ -14,8 +14,13 @@
  */
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
-#include <queue>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 #include "redispp/redispp_export.h"
 #include "sw/redis++/redis++.h"
@@ -25,7 +30,24 @@ namespace library
 {
     namespace redis
     {
-        constexpr int MAX_DB_SIZE = 16; // Redis最大数据库实例数
+        constexpr int MAX_DB_SIZE = 16;                // Redis最大数据库实例数
+        constexpr int MAX_POOL_COUNT = MAX_DB_SIZE * 2; // 连接池数量上限，每个数据库实例主库、从库各一个
+
+        // 连接的角色
+        enum class RedisRole
+        {
+            Default, // 按配置中的master决定连接主库或从库
+            Master,  // 主库，写入、弹出等修改数据的命令必须使用主库
+            Replica, // 从库，通过哨兵发现，每个连接随机选择一个从库，用于监控、查询等只读命令，不占用主库的CPU
+        };
+
+        // 开启autoPipeline时，本线程的命令由其他线程在其连接上合并发送，该连接出错导致没有回复
+        // 本线程持有的连接没有被使用，仍然有效，不需要置为无效；命令可能已被执行，非幂等命令重试前需自行确认
+        class PipelinePeerError : public sw::redis::Error
+        {
+        public:
+            using sw::redis::Error::Error;
+        };
 
         // redis哨兵配置
         struct SentinelConfig
@@ -40,11 +62,34 @@ namespace library
             std::string sentinelPasswd; // 哨兵密码
             std::string redisPasswd;    // Redis密码
             std::string masterName;     // 主库名称
-            bool master;                // 是否连接主库（只有主库才有写权限）
+            bool master;                // RedisRole::Default是否连接主库（只有主库才有写权限），可以按命令指定RedisRole
             int db;                     // 默认的数据库实例id
             int connectTimeout;         // 连接超时时间（毫秒）
             int socketTimeout;          // 请求超时时间（毫秒）
-            int poolSize;               // 连接池大小
+            int poolSize;               // 连接池大小，每个数据库实例最多创建poolSize*5个连接，每个连接一个socket
+            bool threadCache = false;   // 是否为每个线程缓存一个归还的连接，下次获取时不访问共享连接池；缓存的连接在线程退出前不回到共享连接池，线程数较多时可能取不到连接
+            bool warmUp = true;         // Init时是否为默认数据库实例预先创建poolSize个连接并完成连接
+            bool autoPipeline = false;  // 是否自动合并多个线程并发的RedisProxy::Command，由其中一个线程在自己的连接上一次写入、一次往返
+            int pipelineMaxBatch = 64;  // 自动合并时每批最多的命令数
+            int pipelineLingerUs = 0;   // 自动合并时等待凑批的最长时间（微秒），0-只合并已经到达的命令
+        };
+
+        // 连接池统计
+        struct RedisPoolStats
+        {
+            int totalSize = 0; // 当前总的连接数
+            int usedSize = 0;  // 已经使用的连接数（包括线程缓存中的连接）
+            int idleSize = 0;  // 共享连接池中闲置的连接数
+            int repairSize = 0; // 等待后台重连的连接数
+        };
+
+        // 连接统计
+        struct RedisConnectionStats
+        {
+            int dbCount = 0;            // 已创建连接池的数据库实例数
+            int redisConnections = 0;   // 到redis的连接对象数，不含等待重连的；每个连接对象最多占用一个socket，从未使用过的尚未建立socket，因此是socket数的上限
+            int replicaConnections = 0; // 其中到从库的连接对象数
+            int sentinelSockets = 0;    // 到哨兵的socket上限，哨兵对象对每个哨兵节点最多保持一个socket
         };
 
         using SentinelConfigPtr = std::shared_ptr<SentinelConfig>;
@@ -57,38 +102,142 @@ namespace library
         struct RedisPool;
         using RedisPoolPtr = std::shared_ptr<RedisPool>;
         using RedisPoolArray = std::vector<RedisPoolPtr>;
+
+        struct CommandBatcher;
+        using CommandBatcherPtr = std::shared_ptr<CommandBatcher>;
         class REDISPP_EXPORT Redispp : public library::utils::Singleton<Redispp>
         {
         public:
             /**
-             * @brief 初始化连接池
+             * @brief 析构函数，停止后台维护线程
+             */
+            ~Redispp();
+
+            /**
+             * @brief 初始化连接池，并启动后台维护线程负责重连失效的连接
+             * 各数据库实例的连接池在首次使用时创建，连接池是唯一的连接复用层，每个连接对象内部只有一个socket
              * @param sentinelConfigs 哨兵配置
-             * @param redisConfig redis连接配置
+             * 重复调用时先停止并等待维护线程退出、丢弃未完成的重连，再替换配置和连接池后重新启动维护线程；
+             * 调用方需保证期间没有其他线程访问本对象
+             * @param redisConfig redis连接配置，warmUp为true时为默认数据库实例预先创建连接
              */
             void Init(SentinelConfigArray sentinelConfigs, RedisConfigPtr redisConfig);
 
+            /**
+             * @brief 预先创建连接并完成哨兵查询、TCP连接和认证后放入连接池，连接失败的交给后台维护线程重连
+             * @param db 数据库实例id，如果为-1则读取配置文件中的db
+             * @param count 创建的连接数，不超过连接数上限
+             * @param role 连接的角色
+             * @return int 连接成功的数量
+             */
+            int WarmUp(int db, int count, RedisRole role = RedisRole::Default);
+
             /**
              * @brief 获取一个有效的redis连接
              * @param db 数据库实例id，如果为-1则读取配置文件中的db
+             * @param role 连接的角色，主库和从库的连接分别在各自的连接池中
              * @return RedisPtr redis连接实例
              */
-            RedisPtr GetRedis(int db = -1);
+            RedisPtr GetRedis(int db = -1, RedisRole role = RedisRole::Default);
 
             /**
              * @brief 归还一个redis连接
              * @param redis 通过GetRedis获取的redis连接
              * @param isvalid 是否有效，如果调用的过程中出现异常则返还的时候设置为false，如果正常则为true
-             * @param db 数据库实例id，isvalid为false时，会以此重新创建新的连接
+             * @param db 数据库实例id，isvalid为false时，由后台维护线程以此重新创建连接，调用方不等待
+             * @param role 获取连接时指定的角色
              * @return true 成功
              * @return false 失败
              */
-            bool GiveBack(RedisPtr redis, bool isvalid = true, int db = -1);
+            bool GiveBack(RedisPtr redis, bool isvalid = true, int db = -1, RedisRole role = RedisRole::Default);
+
+            /**
+             * @brief 获取redis连接配置
+             * @return RedisConfigPtr redis连接配置，未初始化时为空
+             */
+            RedisConfigPtr GetRedisConfig() const { return _redisConfig; }
+
+            /**
+             * @brief 获取哨兵配置
+             * @return const SentinelConfigArray& 哨兵配置，未初始化时为空
+             */
+            const SentinelConfigArray &GetSentinelConfigs() const { return _sentinelConfigs; }
+
+            /**
+             * @brief 获取数据库实例的命令合并器
+             * @param db 数据库实例id，如果为-1则读取配置文件中的db
+             * @param role 连接的角色
+             * @return CommandBatcherPtr 命令合并器，未开启autoPipeline或db非法时为空
+             */
+            CommandBatcherPtr GetBatcher(int db = -1, RedisRole role = RedisRole::Default);
+
+            /**
+             * @brief 获取连接池统计
+             * @param db 数据库实例id，如果为-1则读取配置文件中的db
+             * @param role 连接的角色
+             * @return RedisPoolStats 连接池统计，未初始化或db非法时全部为0
+             */
+            RedisPoolStats GetPoolStats(int db = -1, RedisRole role = RedisRole::Default) const;
+
+            /**
+             * @brief 获取全部数据库实例的连接统计
+             * @return RedisConnectionStats 连接统计
+             */
+            RedisConnectionStats GetConnectionStats() const;
+
+        private:
+            /**
+             * @brief 计算连接池序号，主库连接池的序号为数据库实例id，从库连接池的序号为数据库实例id + MAX_DB_SIZE
+             * @param db 数据库实例id，如果为-1则读取配置文件中的db
+             * @param role 连接的角色
+             * @return int 连接池序号，未初始化或db非法时为-1
+             */
+            int GetSlot(int db, RedisRole role) const;
+
+            /**
+             * @brief 获取连接池，首次使用时创建
+             * @param slot 连接池序号，调用方保证合法
+             * @return const RedisPoolPtr& 连接池
+             */
+            const RedisPoolPtr &GetPool(int slot);
+
+            /**
+             * @brief 创建一个新的redis连接对象
+             * @param slot 连接池序号，决定数据库实例id和角色
+             * @return RedisPtr redis连接对象
+             */
+            RedisPtr CreateRedis(int slot) const;
+
+            /**
+             * @brief 创建并连接一个redis连接对象
+             * @param slot 连接池序号
+             * @return RedisPtr redis连接对象，连接失败时为空
+             */
+            RedisPtr ConnectRedis(int slot) const;
+
+            /**
+             * @brief 后台维护线程，重连失效的连接，失败时退避重试
+             */
+            void MaintainLoop();
+
+            /**
+             * @brief 通知后台维护线程退出并等待其结束，未启动时直接返回
+             */
+            void StopMaintain();
 
         private:
             SentinelConfigArray _sentinelConfigs; // 哨兵配置
             RedisConfigPtr _redisConfig;          // redis连接配置
             SentinelPtr _sentinel;                // 哨兵对象
-            RedisPoolArray _redisConnPool;        // redis连接池列表
+            RedisPoolArray _redisConnPool;        // redis连接池列表，下标为连接池序号，未使用的为空
+            std::atomic<bool> _redisPoolReady[MAX_POOL_COUNT] = {}; // 连接池是否已创建，创建后_redisConnPool中对应元素不再修改
+            std::mutex _poolMutex;                // 创建连接池时加锁
+
+            std::thread _maintainThread;                        // 后台维护线程
+            std::mutex _maintainMutex;                          // 保护_repairQueue和_stop
+            std::condition_variable _maintainCond;              // 通知维护线程
+            std::deque<std::pair<RedisPoolPtr, int>> _repairQueue; // 等待重连的连接池及连接池序号
+            bool _stop = false;                                 // 是否停止维护线程
         };
 
         class RedisProxy
@@ -97,8 +246,17 @@ namespace library
             /**
              * @brief 构造函数
              * @param db redis数据库实例序号
+             * @param role 连接的角色，只读命令可以指定RedisRole::Replica
              */
-            RedisProxy(int db = -1);
+            RedisProxy(int db = -1, RedisRole role = RedisRole::Default);
+
+            /**
+             * @brief 构造函数，从指定的连接池获取连接，用于访问RedisShards中的分片
+             * @param redispp 连接池
+             * @param db redis数据库实例序号
+             * @param role 连接的角色
+             */
+            RedisProxy(Redispp &redispp, int db = -1, RedisRole role = RedisRole::Default);
 
             /**
              * @brief 析构函数
@@ -111,7 +269,30 @@ namespace library
             void SetInvalid();
 
             /**
-             * @brief 重载->操作符，实现对RedisPtr的调用
+             * @brief 执行一条命令，开启autoPipeline时与其他线程并发的命令合并为一批发送
+             * @param cmd 命令名称
+             * @param args 参数，需要能转换为StringView，调用返回前保持有效
+             * @return sw::redis::ReplyUPtr 回复，redis返回错误时抛出sw::redis::ReplyError，合并发送的其他线程连接出错时抛出PipelinePeerError
+             */
+            template <typename... Args>
+            sw::redis::ReplyUPtr Command(const sw::redis::StringView &cmd, const Args &...args)
+            {
+                sw::redis::StringView argv[] = {cmd, sw::redis::StringView(args)...};
+                return Execute(argv, argv + 1 + sizeof...(Args));
+            }
+
+            /**
+             * @brief 执行一条参数个数不定的命令，开启autoPipeline时与其他线程并发的命令合并为一批发送
+             * @param argv 命令名称及参数，调用返回前保持有效
+             * @return sw::redis::ReplyUPtr 回复，redis返回错误时抛出sw::redis::ReplyError，合并发送的其他线程连接出错时抛出PipelinePeerError
+             */
+            sw::redis::ReplyUPtr Command(const std::vector<sw::redis::StringView> &argv)
+            {
+                return Execute(argv.data(), argv.data() + argv.size());
+            }
+
+            /**
+             * @brief 重载->操作符，实现对RedisPtr的调用，直接调用redis++的接口（包括pipeline）不经过autoPipeline合并
              * @return RedisPtr redis连接对象
              */
             RedisPtr operator->() const;
@@ -153,9 +334,21 @@ namespace library
             bool operator!=(nullptr_t) const;
 
         private:
-            bool _isValid; // 是否有效，用于归还连接时，连接池决定是否重连
-            int _db;       // 数据库实例号
-            RedisPtr _ptr; // 当前的Reids连接对象
+            /**
+             * @brief 执行一条命令
+             * @param first 命令名称及参数的起始位置
+             * @param last 结束位置
+             * @return sw::redis::ReplyUPtr 回复
+             */
+            sw::redis::ReplyUPtr Execute(const sw::redis::StringView *first, const sw::redis::StringView *last);
+
+        private:
+            Redispp *_redispp;           // 连接所属的连接池
+            bool _isValid;               // 是否有效，用于归还连接时，连接池决定是否重连
+            int _db;                     // 数据库实例号
+            RedisRole _role;             // 连接的角色
+            RedisPtr _ptr;               // 当前的Reids连接对象
+            CommandBatcherPtr _batcher;  // 命令合并器，未开启autoPipeline时为空
         };
     } // namespace redis
 } // namespace library
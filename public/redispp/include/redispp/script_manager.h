@@ -0,0 +1,110 @@
+/**
+ * @file script_manager.h
+ * @brief lua脚本注册表，通过SCRIPT LOAD加载一次，之后按SHA1调用EVALSHA
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "redispp/redispp.h"
+#include "redispp/redispp_export.h"
+#include "utils/singleton.h"
+
+namespace library
+{
+    namespace redis
+    {
+        /**
+         * @brief 原子地分配订单编号、推送订单并累加账户订单数的脚本，注册名为ALLOC_PUSH_SCRIPT_NAME
+         * KEYS[1] 订单编号计数器，与IdAllocator使用同一个键时两种方式分配的编号不重复
+         * KEYS[2] 账户订单数的hash，field为账户
+         * KEYS[3..] 订单队列
+         * ARGV[1] 订单编号占位符，订单数据中第一次出现的占位符替换为编号，不足的长度以'\0'填充；为空时不替换
+         * ARGV[2..] 每笔订单依次为(队列在KEYS[3..]中的序号（从1开始）, 账户, 订单数据)
+         * 先检查全部订单再写入，参数错误时不做任何修改并返回错误；成功时返回最后一笔订单的编号
+         */
+        REDISPP_EXPORT extern const char ALLOC_PUSH_SCRIPT[];
+        REDISPP_EXPORT extern const char ALLOC_PUSH_SCRIPT_NAME[];
+
+        // 已注册的lua脚本
+        struct LuaScript
+        {
+            std::string name;        // 脚本名称
+            std::string source;      // 脚本内容
+            std::string sha;         // SHA1，首次加载成功后不再修改
+            std::once_flag loadOnce; // 首次加载，失败时下次调用重试
+        };
+        using LuaScriptPtr = std::shared_ptr<LuaScript>;
+
+        /**
+         * @brief lua脚本注册表
+         * 脚本先注册再使用，首次调用时通过SCRIPT LOAD加载并记录SHA1，之后只发送EVALSHA；
+         * 主从切换或SCRIPT FLUSH后redis返回NOSCRIPT时重新加载并重试一次，调用方无感知。
+         * EVALSHA通过RedisProxy::Command发送，开启autoPipeline时与其他线程的命令合并。
+         */
+        class REDISPP_EXPORT ScriptManager : public library::utils::Singleton<ScriptManager>
+        {
+        public:
+            /**
+             * @brief 注册脚本，同名脚本已存在时返回已有的脚本
+             * @param name 脚本名称
+             * @param source 脚本内容
+             * @return LuaScriptPtr 脚本
+             */
+            LuaScriptPtr Register(const std::string &name, const std::string &source);
+
+            /**
+             * @brief 查找已注册的脚本
+             * @param name 脚本名称
+             * @return LuaScriptPtr 脚本，未注册时为空
+             */
+            LuaScriptPtr Get(const std::string &name) const;
+
+            /**
+             * @brief 通过SCRIPT LOAD加载脚本到当前连接的redis，失败时抛出sw::redis::Error
+             * @param redis redis连接
+             * @param script 脚本
+             */
+            void Load(RedisProxy &redis, LuaScript &script);
+
+            /**
+             * @brief 通过EVALSHA执行脚本，尚未加载或者redis返回NOSCRIPT时先加载
+             * @param redis redis连接
+             * @param script 脚本
+             * @param keys 键
+             * @param args 参数
+             * @return sw::redis::ReplyUPtr 脚本的返回值，脚本出错时抛出sw::redis::ReplyError
+             */
+            sw::redis::ReplyUPtr Eval(RedisProxy &redis, LuaScript &script,
+                                      const std::vector<sw::redis::StringView> &keys,
+                                      const std::vector<sw::redis::StringView> &args);
+
+            /**
+             * @brief 获取因NOSCRIPT重新加载的次数
+             * @return int64_t 重新加载次数
+             */
+            int64_t GetReloadCount() const { return _reloadCount.load(std::memory_order_relaxed); }
+
+        private:
+            mutable std::mutex _mutex;                                // 保护_scripts
+            std::unordered_map<std::string, LuaScriptPtr> _scripts;   // 已注册的脚本，键为名称
+            std::atomic<int64_t> _reloadCount{0};                     // 因NOSCRIPT重新加载的次数
+        };
+    } // namespace redis
+} // namespace library
@@ -0,0 +1,792 @@
+/**
+ * @file async_redis.cpp
+ * @brief 基于hiredis异步接口和epoll事件循环的非阻塞redis客户端
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "redispp/async_redis.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "hiredis/async.h"
+#include "hiredis/hiredis.h"
+#include "utils/exception_utils.h"
+
+namespace library
+{
+    namespace redis
+    {
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr int MIN_RECONNECT_DELAY_MS = 100;  // 重连失败后的最短等待时间（毫秒）
+        static constexpr int MAX_RECONNECT_DELAY_MS = 5000; // 重连失败后的最长等待时间（毫秒）
+
+        // 一条已编码的命令及其回调，发出后由hiredis持有，回调时释放
+        struct AsyncRequest
+        {
+            std::string cmd;        // RESP编码的命令
+            AsyncCallback callback; // 回调
+        };
+
+        using AsyncRequestPtr = std::unique_ptr<AsyncRequest>;
+
+        /**
+         * @brief 追加一个RESP头部，如"*3\r\n"、"$5\r\n"
+         * @param cmd 输出
+         * @param type 类型字符
+         * @param len 长度
+         */
+        static void AppendHeader(std::string &cmd, char type, size_t len)
+        {
+            char buf[24];
+            buf[0] = type;
+            auto end = std::to_chars(buf + 1, buf + sizeof(buf) - 2, len).ptr;
+            *end++ = '\r';
+            *end++ = '\n';
+            cmd.append(buf, end - buf);
+        }
+
+        /**
+         * @brief 将命令编码为RESP数组
+         * @param begin 第一个参数
+         * @param end 最后一个参数之后
+         * @return std::string 编码结果
+         */
+        static std::string FormatCommand(const sw::redis::StringView *begin, const sw::redis::StringView *end)
+        {
+            size_t size = 16;
+            for (auto arg = begin; arg != end; ++arg)
+            {
+                size += arg->size() + 16;
+            }
+
+            std::string cmd;
+            cmd.reserve(size);
+            AppendHeader(cmd, '*', end - begin);
+            for (auto arg = begin; arg != end; ++arg)
+            {
+                AppendHeader(cmd, '$', arg->size());
+                cmd.append(arg->data(), arg->size());
+                cmd.append("\r\n", 2);
+            }
+            return cmd;
+        }
+
+        /**
+         * @brief 读取字符串类的回复元素
+         * @param reply hiredis回复
+         * @return std::string 字符串，整数转为十进制字符串，其他类型为空
+         */
+        static std::string ElementOf(const redisReply *reply)
+        {
+            switch (reply->type)
+            {
+            case REDIS_REPLY_STRING:
+            case REDIS_REPLY_STATUS:
+            case REDIS_REPLY_ERROR:
+            case REDIS_REPLY_VERB:
+            case REDIS_REPLY_DOUBLE:
+            case REDIS_REPLY_BIGNUM:
+                return std::string(reply->str, reply->len);
+            case REDIS_REPLY_INTEGER:
+                return std::to_string(reply->integer);
+            default:
+                return std::string();
+            }
+        }
+
+        /**
+         * @brief 将hiredis回复转换为AsyncReply
+         * @param reply hiredis回复
+         * @param result 输出
+         */
+        static void ConvertReply(const redisReply *reply, AsyncReply &result)
+        {
+            result.ok = true;
+            switch (reply->type)
+            {
+            case REDIS_REPLY_ERROR:
+                result.ok = false;
+                result.error.assign(reply->str, reply->len);
+                break;
+            case REDIS_REPLY_INTEGER:
+            case REDIS_REPLY_BOOL:
+                result.integer = reply->integer;
+                break;
+            case REDIS_REPLY_NIL:
+                result.nil = true;
+                break;
+            case REDIS_REPLY_ARRAY:
+            case REDIS_REPLY_SET:
+            case REDIS_REPLY_MAP:
+            case REDIS_REPLY_PUSH:
+                result.elements.reserve(reply->elements);
+                for (size_t i = 0; i < reply->elements; i++)
+                {
+                    result.elements.push_back(ElementOf(reply->element[i]));
+                }
+                break;
+            default:
+                result.str = ElementOf(reply);
+                break;
+            }
+        }
+
+        /**
+         * @brief 同步连接一个哨兵并执行命令
+         * @param config 哨兵配置
+         * @param redisConfig redis连接配置
+         * @param format 命令格式
+         * @param masterName 主库名称
+         * @return redisReply* 回复，失败时为空，由调用方freeReplyObject
+         */
+        static redisReply *SentinelCommand(const SentinelConfig &config, const RedisConfig &redisConfig, const char *format, const char *masterName)
+        {
+            struct timeval connectTimeout = {redisConfig.connectTimeout / 1000, redisConfig.connectTimeout % 1000 * 1000};
+            struct timeval socketTimeout = {redisConfig.socketTimeout / 1000, redisConfig.socketTimeout % 1000 * 1000};
+            auto context = redisConnectWithTimeout(config.host.c_str(), config.port, connectTimeout);
+            if (!context)
+            {
+                return nullptr;
+            }
+            if (context->err || redisSetTimeout(context, socketTimeout) != REDIS_OK)
+            {
+                redisFree(context);
+                return nullptr;
+            }
+
+            if (!redisConfig.sentinelPasswd.empty())
+            {
+                auto reply = (redisReply *)redisCommand(context, "AUTH %s", redisConfig.sentinelPasswd.c_str());
+                bool ok = reply && reply->type != REDIS_REPLY_ERROR;
+                if (reply)
+                {
+                    freeReplyObject(reply);
+                }
+                if (!ok)
+                {
+                    redisFree(context);
+                    return nullptr;
+                }
+            }
+
+            auto reply = (redisReply *)redisCommand(context, format, masterName);
+            redisFree(context);
+            return reply;
+        }
+
+        /**
+         * @brief 在SENTINEL slaves返回的一个从库信息（键值对数组）中查找字段
+         * @param slave 从库信息
+         * @param name 字段名
+         * @return const redisReply* 字段值，不存在时为空
+         */
+        static const redisReply *SlaveField(const redisReply *slave, const char *name)
+        {
+            for (size_t i = 0; i + 1 < slave->elements; i += 2)
+            {
+                auto key = slave->element[i];
+                if (key->type == REDIS_REPLY_STRING && strcmp(key->str, name) == 0)
+                {
+                    return slave->element[i + 1];
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief 通过哨兵查找主库或一个健康的从库
+         * @param sentinelConfigs 哨兵配置
+         * @param redisConfig redis连接配置
+         * @param host 输出的主机地址
+         * @param port 输出的端口
+         * @return true 成功
+         * @return false 所有哨兵均不可用或没有可用的从库
+         */
+        static bool Discover(const SentinelConfigArray &sentinelConfigs, const RedisConfig &redisConfig, std::string &host, int &port)
+        {
+            for (auto &config : sentinelConfigs)
+            {
+                if (redisConfig.master)
+                {
+                    auto reply = SentinelCommand(*config, redisConfig, "SENTINEL get-master-addr-by-name %s", redisConfig.masterName.c_str());
+                    if (!reply)
+                    {
+                        continue;
+                    }
+                    bool found = reply->type == REDIS_REPLY_ARRAY && reply->elements == 2 && reply->element[0]->type == REDIS_REPLY_STRING &&
+                                 reply->element[1]->type == REDIS_REPLY_STRING;
+                    if (found)
+                    {
+                        host.assign(reply->element[0]->str, reply->element[0]->len);
+                        port = atoi(reply->element[1]->str);
+                    }
+                    freeReplyObject(reply);
+                    if (found)
+                    {
+                        return true;
+                    }
+                    continue;
+                }
+
+                auto reply = SentinelCommand(*config, redisConfig, "SENTINEL slaves %s", redisConfig.masterName.c_str());
+                if (!reply)
+                {
+                    continue;
+                }
+                bool found = false;
+                for (size_t i = 0; reply->type == REDIS_REPLY_ARRAY && i < reply->elements && !found; i++)
+                {
+                    // 跳过主观/客观下线、断开或与主库同步中断的从库
+                    auto slave = reply->element[i];
+                    auto ip = SlaveField(slave, "ip");
+                    auto slavePort = SlaveField(slave, "port");
+                    auto flags = SlaveField(slave, "flags");
+                    auto link = SlaveField(slave, "master-link-status");
+                    if (!ip || !slavePort || !flags || strstr(flags->str, "down") || strstr(flags->str, "disconnected") ||
+                        (link && strcmp(link->str, "ok") != 0))
+                    {
+                        continue;
+                    }
+                    host.assign(ip->str, ip->len);
+                    port = atoi(slavePort->str);
+                    found = true;
+                }
+                freeReplyObject(reply);
+                if (found)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        struct AsyncRedis::Impl
+        {
+            SentinelConfigArray sentinelConfigs; // 哨兵配置
+            RedisConfigPtr redisConfig;          // redis连接配置
+            int db = 0;                          // 数据库实例id
+
+            int epollFd = -1;    // epoll
+            int wakeFd = -1;     // eventfd，提交队列由空变为非空时唤醒事件循环
+            std::thread thread;  // 事件循环线程
+
+            std::mutex submitMutex;                // 保护submitQueue、running、stop
+            std::vector<AsyncRequestPtr> submitQueue; // 提交队列
+            bool running = false;                  // 是否接受新的命令
+            bool stop = false;                     // 是否停止事件循环
+
+            alignas(64) std::atomic<int64_t> inflight{0}; // 已提交但尚未回调的命令数
+
+            // 以下成员只在事件循环线程中访问
+            redisAsyncContext *ac = nullptr;        // 当前连接，断开后为空
+            uint32_t events = 0;                    // 连接在epoll中注册的事件
+            bool timerArmed = false;                // 是否有命令超时定时器
+            Clock::time_point timerDeadline;        // 命令超时时间
+            Clock::time_point reconnectAt;          // 下次连接时间
+            int reconnectDelayMs = MIN_RECONNECT_DELAY_MS; // 连接失败后的等待时间
+            bool addressValid = false;              // host/port是否为Start时查找的地址，只使用一次
+            std::string host;                       // redis地址
+            int port = 0;                           // redis端口
+            std::deque<AsyncRequestPtr> waitQueue;  // 未连接期间提交的命令
+
+            /**
+             * @brief 以失败回调命令
+             * @param request 命令
+             * @param error 失败原因
+             */
+            void Fail(AsyncRequestPtr request, const char *error)
+            {
+                AsyncReply reply;
+                reply.error = error;
+                Complete(*request, reply);
+            }
+
+            /**
+             * @brief 调用命令的回调
+             * @param request 命令
+             * @param reply 回复
+             */
+            void Complete(AsyncRequest &request, AsyncReply &reply)
+            {
+                if (request.callback)
+                {
+                    try
+                    {
+                        request.callback(reply);
+                    }
+                    catch (...)
+                    {
+                        // 回调在hiredis内部调用，异常不能越过事件循环
+                    }
+                }
+                inflight.fetch_sub(1, std::memory_order_release);
+            }
+
+            /**
+             * @brief 提交命令
+             * @param request 命令
+             */
+            void Submit(AsyncRequestPtr request)
+            {
+                inflight.fetch_add(1, std::memory_order_relaxed);
+
+                bool wake;
+                {
+                    std::lock_guard<std::mutex> lock(submitMutex);
+                    if (!running)
+                    {
+                        wake = false;
+                    }
+                    else
+                    {
+                        wake = submitQueue.empty();
+                        submitQueue.push_back(std::move(request));
+                    }
+                }
+
+                if (request)
+                {
+                    Fail(std::move(request), "AsyncRedis未启动");
+                    return;
+                }
+
+                // 只有队列由空变为非空时才需要唤醒，事件循环每次唤醒取走整个队列
+                if (wake)
+                {
+                    uint64_t one = 1;
+                    (void)!write(wakeFd, &one, sizeof(one));
+                }
+            }
+
+            /**
+             * @brief 将命令写入当前连接
+             * @param request 命令
+             */
+            void Send(AsyncRequestPtr request)
+            {
+                if (redisAsyncFormattedCommand(ac, &Impl::OnReply, request.get(), request->cmd.data(), request->cmd.size()) != REDIS_OK)
+                {
+                    Fail(std::move(request), ac->errstr[0] ? ac->errstr : "连接正在断开");
+                    return;
+                }
+                // 命令已复制到hiredis的输出缓冲区，回调时释放
+                std::string().swap(request->cmd);
+                request.release();
+            }
+
+            /**
+             * @brief 查找redis地址并建立连接，失败时退避
+             */
+            void Connect()
+            {
+                if (!addressValid && !Discover(sentinelConfigs, *redisConfig, host, port))
+                {
+                    FailWaiting("所有哨兵均不可用");
+                    Backoff();
+                    return;
+                }
+                addressValid = false;
+
+                struct timeval connectTimeout = {redisConfig->connectTimeout / 1000, redisConfig->connectTimeout % 1000 * 1000};
+                struct timeval commandTimeout = {redisConfig->socketTimeout / 1000, redisConfig->socketTimeout % 1000 * 1000};
+                redisOptions options{};
+                REDIS_OPTIONS_SET_TCP(&options, host.c_str(), port);
+                options.connect_timeout = &connectTimeout;
+                options.command_timeout = &commandTimeout;
+
+                ac = redisAsyncConnectWithOptions(&options);
+                if (!ac || ac->err)
+                {
+                    if (ac)
+                    {
+                        redisAsyncFree(ac);
+                        ac = nullptr;
+                    }
+                    FailWaiting("连接redis失败");
+                    Backoff();
+                    return;
+                }
+
+                // 先挂接事件钩子，设置连接回调时hiredis会注册写事件以检测连接完成
+                ac->data = this;
+                ac->ev.data = this;
+                ac->ev.addRead = &Impl::AddRead;
+                ac->ev.delRead = &Impl::DelRead;
+                ac->ev.addWrite = &Impl::AddWrite;
+                ac->ev.delWrite = &Impl::DelWrite;
+                ac->ev.cleanup = &Impl::Cleanup;
+                ac->ev.scheduleTimer = &Impl::ScheduleTimer;
+                redisAsyncSetConnectCallback(ac, &Impl::OnConnect);
+
+                // 认证和选库排在所有命令之前，失败时断开连接，后续命令以失败回调
+                if (!redisConfig->redisPasswd.empty())
+                {
+                    redisAsyncCommand(ac, &Impl::OnSetup, nullptr, "AUTH %s", redisConfig->redisPasswd.c_str());
+                }
+                if (db != 0)
+                {
+                    redisAsyncCommand(ac, &Impl::OnSetup, nullptr, "SELECT %d", db);
+                }
+
+                while (ac && !waitQueue.empty())
+                {
+                    auto request = std::move(waitQueue.front());
+                    waitQueue.pop_front();
+                    Send(std::move(request));
+                }
+            }
+
+            /**
+             * @brief 以失败回调未连接期间提交的全部命令，命令最多等待一次连接尝试
+             * @param error 失败原因
+             */
+            void FailWaiting(const char *error)
+            {
+                while (!waitQueue.empty())
+                {
+                    auto request = std::move(waitQueue.front());
+                    waitQueue.pop_front();
+                    Fail(std::move(request), error);
+                }
+            }
+
+            /**
+             * @brief 连接失败，等待一段时间后重新查找并连接
+             */
+            void Backoff()
+            {
+                reconnectAt = Clock::now() + std::chrono::milliseconds(reconnectDelayMs);
+                reconnectDelayMs = std::min(reconnectDelayMs * 2, MAX_RECONNECT_DELAY_MS);
+            }
+
+            /**
+             * @brief 更新连接在epoll中注册的事件
+             * @param flag 事件
+             * @param on 注册或取消
+             */
+            void UpdateEvents(uint32_t flag, bool on)
+            {
+                uint32_t newEvents = on ? (events | flag) : (events & ~flag);
+                if (newEvents == events)
+                {
+                    return;
+                }
+
+                struct epoll_event ev = {};
+                ev.events = newEvents;
+                ev.data.fd = ac->c.fd;
+                int op = events == 0 ? EPOLL_CTL_ADD : (newEvents == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD);
+                epoll_ctl(epollFd, op, ac->c.fd, &ev);
+                events = newEvents;
+            }
+
+            static void AddRead(void *privdata) { static_cast<Impl *>(privdata)->UpdateEvents(EPOLLIN, true); }
+            static void DelRead(void *privdata) { static_cast<Impl *>(privdata)->UpdateEvents(EPOLLIN, false); }
+            static void AddWrite(void *privdata) { static_cast<Impl *>(privdata)->UpdateEvents(EPOLLOUT, true); }
+            static void DelWrite(void *privdata) { static_cast<Impl *>(privdata)->UpdateEvents(EPOLLOUT, false); }
+
+            static void ScheduleTimer(void *privdata, struct timeval tv)
+            {
+                auto impl = static_cast<Impl *>(privdata);
+                impl->timerArmed = true;
+                impl->timerDeadline = Clock::now() + std::chrono::seconds(tv.tv_sec) + std::chrono::microseconds(tv.tv_usec);
+            }
+
+            /**
+             * @brief 连接释放（主动释放、断开或连接失败）时由hiredis调用，之后重新查找并连接
+             */
+            static void Cleanup(void *privdata)
+            {
+                auto impl = static_cast<Impl *>(privdata);
+                if (impl->events != 0)
+                {
+                    epoll_ctl(impl->epollFd, EPOLL_CTL_DEL, impl->ac->c.fd, nullptr);
+                    impl->events = 0;
+                }
+                impl->timerArmed = false;
+                impl->ac = nullptr;
+                impl->Backoff();
+            }
+
+            static void OnConnect(const redisAsyncContext *ac, int status)
+            {
+                if (status == REDIS_OK)
+                {
+                    static_cast<Impl *>(ac->data)->reconnectDelayMs = MIN_RECONNECT_DELAY_MS;
+                }
+            }
+
+            static void OnSetup(redisAsyncContext *ac, void *r, void *)
+            {
+                auto reply = static_cast<redisReply *>(r);
+                if (reply && reply->type == REDIS_REPLY_ERROR)
+                {
+                    redisAsyncDisconnect(ac);
+                }
+            }
+
+            static void OnReply(redisAsyncContext *ac, void *r, void *privdata)
+            {
+                auto impl = static_cast<Impl *>(ac->data);
+                AsyncRequestPtr request(static_cast<AsyncRequest *>(privdata));
+                AsyncReply reply;
+                if (r)
+                {
+                    ConvertReply(static_cast<redisReply *>(r), reply);
+                }
+                else
+                {
+                    reply.error = ac->err ? ac->errstr : "连接已断开";
+                }
+                impl->Complete(*request, reply);
+            }
+
+            /**
+             * @brief 计算epoll_wait的超时时间
+             * @return int 毫秒，-1表示无限等待
+             */
+            int WaitTimeout() const
+            {
+                Clock::time_point deadline;
+                if (ac)
+                {
+                    if (!timerArmed)
+                    {
+                        return -1;
+                    }
+                    deadline = timerDeadline;
+                }
+                else
+                {
+                    deadline = reconnectAt;
+                }
+
+                auto now = Clock::now();
+                if (deadline <= now)
+                {
+                    return 0;
+                }
+                return (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+            }
+
+            /**
+             * @brief 事件循环
+             */
+            void Loop()
+            {
+                std::vector<AsyncRequestPtr> batch;
+                struct epoll_event readyEvents[8];
+                reconnectAt = Clock::now();
+                while (true)
+                {
+                    int n = epoll_wait(epollFd, readyEvents, 8, WaitTimeout());
+                    for (int i = 0; i < n; i++)
+                    {
+                        if (readyEvents[i].data.fd == wakeFd)
+                        {
+                            uint64_t count;
+                            (void)!read(wakeFd, &count, sizeof(count));
+                            continue;
+                        }
+
+                        // 读写处理中连接可能被释放
+                        auto ready = readyEvents[i].events;
+                        if (ac && (ready & (EPOLLIN | EPOLLERR | EPOLLHUP)))
+                        {
+                            redisAsyncHandleRead(ac);
+                        }
+                        if (ac && (ready & (EPOLLOUT | EPOLLERR | EPOLLHUP)))
+                        {
+                            redisAsyncHandleWrite(ac);
+                        }
+                    }
+
+                    if (ac && timerArmed && Clock::now() >= timerDeadline)
+                    {
+                        timerArmed = false;
+                        redisAsyncHandleTimeout(ac);
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(submitMutex);
+                        if (stop)
+                        {
+                            running = false;
+                            batch.swap(submitQueue);
+                            break;
+                        }
+                        batch.swap(submitQueue);
+                    }
+
+                    for (auto &request : batch)
+                    {
+                        if (ac)
+                        {
+                            Send(std::move(request));
+                        }
+                        else
+                        {
+                            waitQueue.push_back(std::move(request));
+                        }
+                    }
+                    batch.clear();
+
+                    if (!ac && Clock::now() >= reconnectAt)
+                    {
+                        Connect();
+                    }
+                }
+
+                // 释放连接时hiredis以空回复调用已发出命令的回调
+                if (ac)
+                {
+                    redisAsyncFree(ac);
+                }
+                FailWaiting("AsyncRedis已停止");
+                for (auto &request : batch)
+                {
+                    Fail(std::move(request), "AsyncRedis已停止");
+                }
+            }
+        };
+
+        AsyncRedis::AsyncRedis()
+            : _impl(new Impl)
+        {
+        }
+
+        AsyncRedis::~AsyncRedis()
+        {
+            Stop();
+        }
+
+        void AsyncRedis::Start(int db)
+        {
+            auto redispp = Redispp::Instance();
+            if (!redispp->GetRedisConfig())
+            {
+                throw library::utils::Exception("Redispp未初始化");
+            }
+            Start(redispp->GetSentinelConfigs(), redispp->GetRedisConfig(), db);
+        }
+
+        void AsyncRedis::Start(const SentinelConfigArray &sentinelConfigs, const RedisConfigPtr &redisConfig, int db)
+        {
+            if (_impl->thread.joinable())
+            {
+                throw library::utils::Exception("AsyncRedis已经启动");
+            }
+
+            auto &impl = *_impl;
+            impl.sentinelConfigs = sentinelConfigs;
+            impl.redisConfig = redisConfig;
+            impl.db = (-1 == db) ? redisConfig->db : db;
+            if (impl.db >= MAX_DB_SIZE || impl.db < 0)
+            {
+                throw library::utils::Exception("数据库实例id非法");
+            }
+
+            // 启动时查找一次地址，哨兵全部不可用时直接报错，之后的重连在事件循环中重新查找
+            if (!Discover(sentinelConfigs, *redisConfig, impl.host, impl.port))
+            {
+                throw library::utils::Exception("所有哨兵均不可用或找不到" + redisConfig->masterName + (redisConfig->master ? "的主库" : "的从库"));
+            }
+            impl.addressValid = true;
+            impl.reconnectDelayMs = MIN_RECONNECT_DELAY_MS;
+
+            impl.epollFd = epoll_create1(EPOLL_CLOEXEC);
+            impl.wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            struct epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.fd = impl.wakeFd;
+            if (impl.epollFd < 0 || impl.wakeFd < 0 || epoll_ctl(impl.epollFd, EPOLL_CTL_ADD, impl.wakeFd, &ev) != 0)
+            {
+                std::string error = std::string("创建事件循环失败:") + strerror(errno);
+                if (impl.epollFd >= 0)
+                {
+                    close(impl.epollFd);
+                }
+                if (impl.wakeFd >= 0)
+                {
+                    close(impl.wakeFd);
+                }
+                impl.epollFd = impl.wakeFd = -1;
+                throw library::utils::Exception(error);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(impl.submitMutex);
+                impl.running = true;
+                impl.stop = false;
+            }
+            impl.thread = std::thread(&Impl::Loop, &impl);
+        }
+
+        void AsyncRedis::Stop()
+        {
+            auto &impl = *_impl;
+            if (!impl.thread.joinable())
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(impl.submitMutex);
+                impl.stop = true;
+            }
+            uint64_t one = 1;
+            (void)!write(impl.wakeFd, &one, sizeof(one));
+            impl.thread.join();
+
+            close(impl.epollFd);
+            close(impl.wakeFd);
+            impl.epollFd = impl.wakeFd = -1;
+        }
+
+        void AsyncRedis::Command(std::initializer_list<sw::redis::StringView> args, AsyncCallback callback)
+        {
+            AsyncRequestPtr request(new AsyncRequest{FormatCommand(args.begin(), args.end()), std::move(callback)});
+            _impl->Submit(std::move(request));
+        }
+
+        void AsyncRedis::Command(const std::vector<sw::redis::StringView> &args, AsyncCallback callback)
+        {
+            AsyncRequestPtr request(new AsyncRequest{FormatCommand(args.data(), args.data() + args.size()), std::move(callback)});
+            _impl->Submit(std::move(request));
+        }
+
+        std::future<AsyncReply> AsyncRedis::Command(std::initializer_list<sw::redis::StringView> args)
+        {
+            auto promise = std::make_shared<std::promise<AsyncReply>>();
+            auto future = promise->get_future();
+            Command(args, [promise](AsyncReply &reply)
+                    { promise->set_value(std::move(reply)); });
+            return future;
+        }
+
+        int64_t AsyncRedis::GetInflight() const
+        {
+            return _impl->inflight.load(std::memory_order_acquire);
+        }
+    } // namespace redis
+} // namespace library
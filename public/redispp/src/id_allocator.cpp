@@ -0,0 +1,111 @@
+/**
+ * @file id_allocator.cpp
+ * @brief 号段式编号分配器
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "redispp/id_allocator.h"
+
+#include "redispp/redispp.h"
+
+namespace library
+{
+    namespace redis
+    {
+        IdAllocator::IdAllocator(const std::string &key, int64_t blockSize, int db)
+            : _key(key), _blockSize(blockSize > 0 ? blockSize : 1), _db(db)
+        {
+            _worker = std::thread(&IdAllocator::PrefetchLoop, this);
+        }
+
+        IdAllocator::~IdAllocator()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mtx);
+                _stop = true;
+            }
+            _cv.notify_one();
+            _worker.join();
+        }
+
+        void IdAllocator::SwitchBlock()
+        {
+            // 首个号段或者预取失败后重试时，预取尚未发起
+            if (!_pending)
+            {
+                RequestPrefetch();
+            }
+
+            int64_t start = 0;
+            while ((start = _nextStart.exchange(0, std::memory_order_acquire)) == 0)
+            {
+                if (_failed.load(std::memory_order_acquire))
+                {
+                    _failed.store(false, std::memory_order_relaxed);
+                    _pending = false;
+                    std::rethrow_exception(_error);
+                }
+                std::this_thread::yield();
+            }
+
+            _pending = false;
+            _cur = start;
+            _end = start + _blockSize;
+            _prefetchMark = _cur + (_blockSize + 1) / 2;
+        }
+
+        void IdAllocator::RequestPrefetch()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mtx);
+                _requested = true;
+            }
+            _cv.notify_one();
+            _pending = true;
+        }
+
+        void IdAllocator::PrefetchLoop()
+        {
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_mtx);
+                    _cv.wait(lock, [this]
+                             { return _stop || _requested; });
+                    if (_stop)
+                    {
+                        return;
+                    }
+                    _requested = false;
+                }
+
+                RedisProxy redis(_db);
+                try
+                {
+                    if (redis == nullptr)
+                    {
+                        throw sw::redis::Error("Redis连接数不够");
+                    }
+
+                    // INCRBY返回号段的最后一个编号
+                    int64_t last = redis->incrby(_key, _blockSize);
+                    _nextStart.store(last - _blockSize + 1, std::memory_order_release);
+                }
+                catch (const sw::redis::Error &e)
+                {
+                    redis.SetInvalid();
+                    _error = std::current_exception();
+                    _failed.store(true, std::memory_order_release);
+                }
+            }
+        }
+    } // namespace redis
+} // namespace library
@@ -0,0 +1,106 @@
+/**
+ * @file redis_shards.cpp
+ * @brief 多组哨兵/主库的客户端分片
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "redispp/redis_shards.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "utils/exception_utils.h"
+
+namespace library
+{
+    namespace redis
+    {
+        /**
+         * @brief 64位FNV-1a哈希，再经murmur3的fmix64打散，相近的键（如连续的账户）也能均匀分布在哈希环上
+         * @param data 数据
+         * @param size 长度
+         * @return uint64_t 哈希值，与平台和进程无关
+         */
+        static uint64_t HashKey(const char *data, size_t size)
+        {
+            uint64_t h = 14695981039346656037ULL;
+            for (size_t i = 0; i < size; i++)
+            {
+                h ^= (uint8_t)data[i];
+                h *= 1099511628211ULL;
+            }
+
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        void RedisShards::Init(const ShardConfigArray &configs)
+        {
+            if (configs.empty())
+            {
+                throw library::utils::Exception("至少需要一个分片");
+            }
+
+            std::unordered_set<std::string> names;
+            for (auto &config : configs)
+            {
+                auto name = config.name.empty() ? config.redisConfig->masterName : config.name;
+                if (!names.insert(name).second)
+                {
+                    throw library::utils::Exception("分片名称重复:" + name);
+                }
+                _names.push_back(name);
+            }
+
+            for (size_t i = 0; i < configs.size(); i++)
+            {
+                Redispp *redispp = Redispp::Instance();
+                if (i > 0)
+                {
+                    _owned.emplace_back(new Redispp());
+                    redispp = _owned.back().get();
+                }
+                redispp->Init(configs[i].sentinelConfigs, configs[i].redisConfig);
+                _shards.push_back(redispp);
+
+                for (int v = 0; v < VIRTUAL_NODES; v++)
+                {
+                    auto node = _names[i] + "#" + std::to_string(v);
+                    _ring.emplace_back(HashKey(node.data(), node.size()), (int)i);
+                }
+            }
+            std::sort(_ring.begin(), _ring.end());
+        }
+
+        const std::string &RedisShards::GetShardName(int idx) const
+        {
+            static const std::string empty;
+            return _names.empty() ? empty : _names[idx];
+        }
+
+        int RedisShards::Locate(const sw::redis::StringView &routeKey) const
+        {
+            if (_shards.size() <= 1)
+            {
+                return 0;
+            }
+
+            // 顺时针找到第一个不小于键哈希值的虚拟节点，超过最后一个时回到起点
+            auto hash = HashKey(routeKey.data(), routeKey.size());
+            auto itor = std::lower_bound(_ring.begin(), _ring.end(), std::make_pair(hash, 0));
+            return itor == _ring.end() ? _ring.front().second : itor->second;
+        }
+    } // namespace redis
+} // namespace library
@@ -14,24 +14,391 @@
  */
 #include "redispp/redispp.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
 #include <vector>
 
 namespace library
 {
     namespace redis
     {
+        /**
+         * @brief 有界无锁多生产者多消费者环形队列，每个单元带序号，生产者和消费者各自CAS推进位置，
+         * 单元中的连接只由抢到该位置的线程读写
+         */
+        class RedisRing
+        {
+        public:
+            explicit RedisRing(size_t capacity)
+            {
+                size_t size = 2;
+                while (size < capacity)
+                {
+                    size <<= 1;
+                }
+                _mask = size - 1;
+                _cells.reset(new Cell[size]);
+                for (size_t i = 0; i < size; i++)
+                {
+                    _cells[i].seq.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @brief 放入一个连接
+             * @param redis 连接
+             * @return true 成功
+             * @return false 队列已满
+             */
+            bool Push(RedisPtr &&redis)
+            {
+                Cell *cell;
+                size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    cell = &_cells[pos & _mask];
+                    size_t seq = cell->seq.load(std::memory_order_acquire);
+                    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+                    if (diff == 0)
+                    {
+                        if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        pos = _enqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                cell->redis = std::move(redis);
+                cell->seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief 取出一个连接
+             * @param redis 取出的连接
+             * @return true 成功
+             * @return false 队列为空
+             */
+            bool Pop(RedisPtr &redis)
+            {
+                Cell *cell;
+                size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    cell = &_cells[pos & _mask];
+                    size_t seq = cell->seq.load(std::memory_order_acquire);
+                    intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+                    if (diff == 0)
+                    {
+                        if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        pos = _dequeuePos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                redis = std::move(cell->redis);
+                cell->seq.store(pos + _mask + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            struct alignas(64) Cell
+            {
+                std::atomic<size_t> seq; // 单元序号
+                RedisPtr redis;          // 连接
+            };
+
+            std::unique_ptr<Cell[]> _cells;              // 单元数组
+            size_t _mask;                                // 单元数量-1
+            alignas(64) std::atomic<size_t> _enqueuePos{0}; // 下一个放入位置
+            alignas(64) std::atomic<size_t> _dequeuePos{0}; // 下一个取出位置
+        };
+
+        /**
+         * @brief 命令合并器，合并多个线程并发提交的单条命令
+         * 先到达的线程成为发送者，等待凑批（不超过lingerUs）后在自己的连接上一次写入整批命令并依次读取回复，
+         * 其他线程只把命令放入等待队列并阻塞到回复就绪；同一时刻只有一个发送者，发送期间到达的命令组成下一批。
+         */
+        struct CommandBatcher
+        {
+            // 一条等待发送的命令，位于提交线程的栈上
+            struct Request
+            {
+                const sw::redis::StringView *first; // 命令名称及参数
+                const sw::redis::StringView *last;
+                sw::redis::ReplyUPtr reply;         // 回复
+                std::exception_ptr error;           // 发送或接收失败时的异常
+                bool done = false;                  // 是否已完成
+            };
+
+            CommandBatcher(int maxBatch, int lingerUs)
+                : maxBatch(std::max(maxBatch, 1)), linger(std::max(lingerUs, 0))
+            {
+            }
+
+            /**
+             * @brief 提交一条命令并等待回复
+             * @param redis 调用线程持有的连接，成为发送者时使用
+             * @param first 命令名称及参数的起始位置
+             * @param last 结束位置
+             * @param broken 输出，调用线程的连接在发送时出错
+             * @return sw::redis::ReplyUPtr 回复
+             */
+            sw::redis::ReplyUPtr Execute(const RedisPtr &redis, const sw::redis::StringView *first, const sw::redis::StringView *last, bool &broken)
+            {
+                Request request;
+                request.first = first;
+                request.last = last;
+
+                std::vector<Request *> batch;
+                std::unique_lock<std::mutex> lock(mutex);
+                pending.push_back(&request);
+                if (pending.size() >= maxBatch)
+                {
+                    fullCond.notify_one();
+                }
+
+                while (!request.done)
+                {
+                    if (flushing)
+                    {
+                        doneCond.wait(lock);
+                        continue;
+                    }
+
+                    // 成为发送者，凑批后取出最早的maxBatch条命令
+                    flushing = true;
+                    if (linger.count() > 0 && pending.size() < maxBatch)
+                    {
+                        fullCond.wait_for(lock, linger, [this]
+                                          { return pending.size() >= maxBatch; });
+                    }
+                    size_t count = std::min(pending.size(), maxBatch);
+                    batch.assign(pending.begin(), pending.begin() + count);
+                    pending.erase(pending.begin(), pending.begin() + count);
+
+                    lock.unlock();
+                    auto error = Flush(*redis, batch, &request);
+                    lock.lock();
+
+                    for (auto item : batch)
+                    {
+                        item->done = true;
+                    }
+                    flushing = false;
+
+                    // 连接已失效，本线程的命令若还在队列中则不再由本线程发送
+                    if (error)
+                    {
+                        broken = true;
+                        if (!request.done)
+                        {
+                            pending.erase(std::find(pending.begin(), pending.end(), &request));
+                            request.error = error;
+                            request.done = true;
+                        }
+                    }
+                    doneCond.notify_all();
+                }
+                lock.unlock();
+
+                if (request.error)
+                {
+                    std::rethrow_exception(request.error);
+                }
+                if (sw::redis::reply::is_error(*request.reply))
+                {
+                    sw::redis::throw_error(*request.reply);
+                }
+                return std::move(request.reply);
+            }
+
+            /**
+             * @brief 在一个连接上发送整批命令并读取回复，输出缓冲区在读取第一个回复时一次写出
+             * @param redis 连接
+             * @param batch 命令
+             * @param self 发送者自己的命令，不在本批中时为其他值
+             * @return std::exception_ptr 连接出错时的异常，此时发送者没有回复的命令以该异常失败，其他线程的命令以PipelinePeerError失败
+             */
+            std::exception_ptr Flush(sw::redis::Redis &redis, std::vector<Request *> &batch, const Request *self)
+            {
+                std::vector<const char *> argv;
+                std::vector<size_t> argvLen;
+                auto cmd = [&batch, &argv, &argvLen](sw::redis::Connection &connection)
+                {
+                    for (auto item : batch)
+                    {
+                        argv.clear();
+                        argvLen.clear();
+                        for (auto arg = item->first; arg != item->last; ++arg)
+                        {
+                            argv.push_back(arg->data());
+                            argvLen.push_back(arg->size());
+                        }
+                        connection.send((int)argv.size(), argv.data(), argvLen.data());
+                    }
+
+                    // 最后一条命令的回复由redis++读取
+                    for (size_t i = 0; i + 1 < batch.size(); i++)
+                    {
+                        batch[i]->reply = connection.recv(false);
+                    }
+                };
+
+                try
+                {
+                    batch.back()->reply = redis.command(cmd);
+                }
+                catch (const sw::redis::ReplyError &)
+                {
+                    // 最后一条命令返回错误，连接仍然有效
+                    batch.back()->error = std::current_exception();
+                }
+                catch (const sw::redis::Error &e)
+                {
+                    // 其他线程的连接没有出错，给它们可区分的异常，避免把自己的连接也置为无效
+                    auto error = std::current_exception();
+                    auto peerError = std::make_exception_ptr(PipelinePeerError(std::string("pipelined connection failed: ") + e.what()));
+                    for (auto item : batch)
+                    {
+                        if (!item->reply)
+                        {
+                            item->error = item == self ? error : peerError;
+                        }
+                    }
+                    return error;
+                }
+                return nullptr;
+            }
+
+            const size_t maxBatch;                   // 每批最多的命令数
+            const std::chrono::microseconds linger;  // 等待凑批的最长时间
+            std::mutex mutex;                        // 保护以下成员
+            std::condition_variable doneCond;        // 一批命令完成
+            std::condition_variable fullCond;        // 等待队列已满一批
+            std::vector<Request *> pending;          // 等待发送的命令
+            bool flushing = false;                   // 是否有线程正在凑批或发送
+        };
+
         // redis连接池配置
         struct RedisPool
         {
-            int totalSize;                   // 当前总的连接数
-            int usedSize;                    // 已经使用的连接数
-            int idleSize;                    // 闲置的连接数
-            std::mutex mtx;                  // 连接池锁
-            std::queue<RedisPtr> redisQueue; // redis连接队列
+            explicit RedisPool(int maxSize)
+                : maxSize(maxSize), redisRing(maxSize)
+            {
+            }
+
+            /**
+             * @brief 将连接放回共享队列
+             * @param redis 连接
+             */
+            void Release(RedisPtr &&redis)
+            {
+                usedSize.fetch_sub(1, std::memory_order_relaxed);
+                // 队列容量不小于最大连接数，正常情况下不会满
+                AddIdle(std::move(redis));
+            }
+
+            /**
+             * @brief 放入新建的连接
+             * @param redis 连接
+             */
+            void AddIdle(RedisPtr &&redis)
+            {
+                if (redisRing.Push(std::move(redis)))
+                {
+                    idleSize.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    totalSize.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+
+            const int maxSize;                          // 最大连接数
+            RedisRing redisRing;                        // 闲置的redis连接
+            alignas(64) std::atomic<int> totalSize{0};  // 当前总的连接数
+            alignas(64) std::atomic<int> usedSize{0};   // 已经使用的连接数
+            alignas(64) std::atomic<int> idleSize{0};   // 闲置的连接数
+            std::atomic<int> repairSize{0};             // 等待后台重连的连接数
+            CommandBatcherPtr batcher;                  // 命令合并器，开启autoPipeline时创建
+        };
+
+        // 线程缓存的连接，每个连接池序号一个，线程退出时放回所属的连接池
+        struct ThreadRedisCache
+        {
+            struct Entry
+            {
+                RedisPoolPtr pool; // 连接所属的连接池
+                RedisPtr redis;    // 缓存的连接
+            };
+
+            ~ThreadRedisCache()
+            {
+                for (auto &entry : entries)
+                {
+                    if (entry.redis)
+                    {
+                        entry.pool->Release(std::move(entry.redis));
+                    }
+                }
+            }
+
+            Entry entries[MAX_POOL_COUNT];
         };
 
+        static thread_local ThreadRedisCache t_redisCache;
+
+        static constexpr int MAX_POP_RETRY = 64; // 连接数已达上限时，等待其他线程归还连接的最大重试次数
+        static constexpr int MIN_REPAIR_DELAY_MS = 100;  // 重连失败后的最短等待时间（毫秒）
+        static constexpr int MAX_REPAIR_DELAY_MS = 5000; // 重连失败后的最长等待时间（毫秒）
+
+        Redispp::~Redispp()
+        {
+            StopMaintain();
+        }
+
+        void Redispp::StopMaintain()
+        {
+            if (!_maintainThread.joinable())
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_maintainMutex);
+                _stop = true;
+            }
+            _maintainCond.notify_all();
+            _maintainThread.join();
+        }
+
         void Redispp::Init(SentinelConfigArray sentinelConfigs, RedisConfigPtr redisConfig)
         {
+            // 维护线程会读取配置、哨兵和连接池，重新初始化前先停止，旧连接池的重连请求一并丢弃
+            StopMaintain();
+            _repairQueue.clear();
+            _stop = false;
+
             _sentinelConfigs = sentinelConfigs;
             _redisConfig = redisConfig;
 
@@ -51,115 +418,366 @@ namespace library
             // 创建哨兵对象
             _sentinel = std::make_shared<sw::redis::Sentinel>(ops);
 
-            // 创建Redis连接池（所有数据库实例）
-            for (int i = 0; i < MAX_DB_SIZE; i++)
+            // Redis连接池在数据库实例首次使用时创建
+            _redisConnPool.assign(MAX_POOL_COUNT, nullptr);
+            for (auto &ready : _redisPoolReady)
+            {
+                ready.store(false, std::memory_order_relaxed);
+            }
+
+            _maintainThread = std::thread(&Redispp::MaintainLoop, this);
+
+            // 预先建立连接，避免首批请求承担哨兵查询、TCP连接和认证的耗时
+            if (_redisConfig->warmUp)
             {
-                std::shared_ptr<RedisPool> redisPool = std::make_shared<RedisPool>();
-                redisPool->totalSize = 0;
-                redisPool->usedSize = 0;
-                redisPool->idleSize = 0;
-                _redisConnPool.push_back(redisPool);
+                WarmUp(_redisConfig->db, _redisConfig->poolSize);
             }
         }
 
-        RedisPtr Redispp::GetRedis(int db)
+        int Redispp::GetSlot(int db, RedisRole role) const
         {
-            if (!_sentinel)
+            if (!_redisConfig)
             {
-                return nullptr;
+                return -1;
             }
 
             // db=-1时，取默认配置文件中的数据库实例
             int idx = (-1 == db) ? _redisConfig->db : db;
-            if (idx > MAX_DB_SIZE || idx < 0)
+            if (idx >= MAX_DB_SIZE || idx < 0)
             {
-                return nullptr;
+                return -1;
             }
 
-            RedisPtr redis = nullptr;
-            auto redisPool = _redisConnPool[idx];
+            bool replica = role == RedisRole::Replica || (role == RedisRole::Default && !_redisConfig->master);
+            return replica ? idx + MAX_DB_SIZE : idx;
+        }
 
-            // 若连接池不为空，则从连接池中取出一个连接
-            std::unique_lock<std::mutex> lock(redisPool->mtx);
-            std::queue<RedisPtr> &redisQueue = redisPool->redisQueue;
-            if (!redisQueue.empty())
+        const RedisPoolPtr &Redispp::GetPool(int slot)
+        {
+            if (!_redisPoolReady[slot].load(std::memory_order_acquire))
             {
-                redis = redisQueue.front();
-                redisQueue.pop();
-                if (redis != nullptr)
+                // 首次使用时创建连接池，最大连接数为配置的5倍，上限在GetRedis和WarmUp预占连接数时检查
+                std::lock_guard<std::mutex> lock(_poolMutex);
+                if (!_redisConnPool[slot])
                 {
-                    redisPool->usedSize++;
-                    redisPool->idleSize--;
-                    return redis;
+                    _redisConnPool[slot] = std::make_shared<RedisPool>(std::max(_redisConfig->poolSize, 1) * 5);
+                    if (_redisConfig->autoPipeline)
+                    {
+                        _redisConnPool[slot]->batcher = std::make_shared<CommandBatcher>(_redisConfig->pipelineMaxBatch, _redisConfig->pipelineLingerUs);
+                    }
+                }
+                _redisPoolReady[slot].store(true, std::memory_order_release);
+            }
+            return _redisConnPool[slot];
+        }
+
+        int Redispp::WarmUp(int db, int count, RedisRole role)
+        {
+            int slot = GetSlot(db, role);
+            if (!_sentinel || slot < 0)
+            {
+                return 0;
+            }
+
+            auto &redisPool = GetPool(slot);
+            int connected = 0;
+            for (int i = 0; i < count; i++)
+            {
+                int total = redisPool->totalSize.load(std::memory_order_relaxed);
+                do
+                {
+                    if (total >= redisPool->maxSize)
+                    {
+                        return connected;
+                    }
+                } while (!redisPool->totalSize.compare_exchange_weak(total, total + 1, std::memory_order_relaxed));
+
+                auto redis = ConnectRedis(slot);
+                if (redis)
+                {
+                    redisPool->AddIdle(std::move(redis));
+                    connected++;
+                    continue;
                 }
 
-                // 将失效的连接去除
-                redisPool->totalSize--;
+                // 连接失败，交给后台维护线程重连
+                redisPool->repairSize.fetch_add(1, std::memory_order_relaxed);
+                {
+                    std::lock_guard<std::mutex> lock(_maintainMutex);
+                    _repairQueue.emplace_back(redisPool, slot);
+                }
+                _maintainCond.notify_one();
             }
+            return connected;
+        }
 
-            // 若总连接数已经超过5倍的配置，则不再新建连接
-            if (redisPool->totalSize >= _redisConfig->poolSize * 5)
+        RedisPtr Redispp::ConnectRedis(int slot) const
+        {
+            try
+            {
+                auto redis = CreateRedis(slot);
+                redis->ping();
+                return redis;
+            }
+            catch (const sw::redis::Error &)
             {
                 return nullptr;
             }
+        }
+
+        void Redispp::MaintainLoop()
+        {
+            int delayMs = MIN_REPAIR_DELAY_MS;
+            std::unique_lock<std::mutex> lock(_maintainMutex);
+            while (true)
+            {
+                _maintainCond.wait(lock, [this]
+                                   { return _stop || !_repairQueue.empty(); });
+                if (_stop)
+                {
+                    break;
+                }
+
+                auto item = _repairQueue.front();
+                _repairQueue.pop_front();
+
+                // 连接过程不持有锁，归还失效连接的线程不会被阻塞
+                lock.unlock();
+                auto redis = ConnectRedis(item.second);
+                lock.lock();
+
+                if (redis)
+                {
+                    item.first->repairSize.fetch_sub(1, std::memory_order_relaxed);
+                    item.first->AddIdle(std::move(redis));
+                    delayMs = MIN_REPAIR_DELAY_MS;
+                    continue;
+                }
 
-            // 创建新的连接
+                // 重连失败，放回队列末尾，退避后重试
+                _repairQueue.push_back(item);
+                _maintainCond.wait_for(lock, std::chrono::milliseconds(delayMs), [this]
+                                       { return _stop; });
+                delayMs = std::min(delayMs * 2, MAX_REPAIR_DELAY_MS);
+            }
+        }
+
+        RedisPtr Redispp::CreateRedis(int slot) const
+        {
             sw::redis::ConnectionOptions connectionOpts;
             connectionOpts.password = _redisConfig->redisPasswd;                                      // Optional. No password by default.
             connectionOpts.connect_timeout = std::chrono::milliseconds(_redisConfig->connectTimeout); // Required.
             connectionOpts.socket_timeout = std::chrono::milliseconds(_redisConfig->socketTimeout);   // Required.
-            connectionOpts.db = idx;
+            connectionOpts.db = slot % MAX_DB_SIZE;
 
+            // 连接对象由本连接池独占使用，redis++内部只需要一个连接
             sw::redis::ConnectionPoolOptions poolOpts;
-            poolOpts.size = _redisConfig->poolSize; // Optional. The default size is 1.
-            redis = std::make_shared<sw::redis::Redis>(_sentinel, _redisConfig->masterName, (_redisConfig->master ? sw::redis::Role::MASTER : sw::redis::Role::SLAVE), connectionOpts, poolOpts);
-            redisPool->totalSize++;
-            redisPool->usedSize++;
-            redisPool->idleSize = 0;
+            poolOpts.size = 1;
+            // 从库连接由哨兵随机选择一个在线的从库，多个连接分散在全部从库上
+            auto role = slot >= MAX_DB_SIZE ? sw::redis::Role::SLAVE : sw::redis::Role::MASTER;
+            return std::make_shared<sw::redis::Redis>(_sentinel, _redisConfig->masterName, role, connectionOpts, poolOpts);
+        }
+
+        RedisPtr Redispp::GetRedis(int db, RedisRole role)
+        {
+            int slot = GetSlot(db, role);
+            if (!_sentinel || slot < 0)
+            {
+                return nullptr;
+            }
+
+            auto &redisPool = GetPool(slot);
+
+            // 优先使用本线程缓存的连接，不访问共享连接池
+            if (_redisConfig->threadCache)
+            {
+                auto &entry = t_redisCache.entries[slot];
+                if (entry.redis && entry.pool == redisPool)
+                {
+                    return std::move(entry.redis);
+                }
+            }
+
+            RedisPtr redis;
+            for (int retry = 0;; retry++)
+            {
+                // 若连接池不为空，则从连接池中取出一个连接
+                if (redisPool->redisRing.Pop(redis))
+                {
+                    redisPool->idleSize.fetch_sub(1, std::memory_order_relaxed);
+                    redisPool->usedSize.fetch_add(1, std::memory_order_relaxed);
+                    return redis;
+                }
+
+                // 预占一个连接数，若总连接数已经达到5倍的配置，则不再新建连接
+                int total = redisPool->totalSize.load(std::memory_order_relaxed);
+                if (total < redisPool->maxSize)
+                {
+                    if (redisPool->totalSize.compare_exchange_weak(total, total + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                // 已达到上限，若其他线程正在归还连接（已占位但尚未写完），稍后重试，否则不再新建连接
+                if (redisPool->idleSize.load(std::memory_order_relaxed) <= 0 || retry >= MAX_POP_RETRY)
+                {
+                    return nullptr;
+                }
+                std::this_thread::yield();
+            }
+
+            // 创建新的连接，不持有任何锁
+            try
+            {
+                redis = CreateRedis(slot);
+            }
+            catch (...)
+            {
+                redisPool->totalSize.fetch_sub(1, std::memory_order_relaxed);
+                throw;
+            }
+            redisPool->usedSize.fetch_add(1, std::memory_order_relaxed);
             return redis;
         }
 
-        bool Redispp::GiveBack(RedisPtr redis, bool isvalid, int db)
+        bool Redispp::GiveBack(RedisPtr redis, bool isvalid, int db, RedisRole role)
         {
-            // db=-1时，取默认配置文件中的数据库实例
-            int idx = (-1 == db) ? _redisConfig->db : db;
-            if (idx > MAX_DB_SIZE || idx < 0)
+            int slot = GetSlot(db, role);
+            if (slot < 0 || !redis)
             {
                 return false;
             }
 
-            // 若连接已经失败，则重新创建一个连接再放回连接池
+            // 若连接已经失败，则丢弃该连接，由后台维护线程重新创建连接再放回连接池
+            auto &redisPool = GetPool(slot);
             if (!isvalid)
             {
-                sw::redis::ConnectionOptions connectionOpts;
-                connectionOpts.password = _redisConfig->redisPasswd;                                      // Optional. No password by default.
-                connectionOpts.connect_timeout = std::chrono::milliseconds(_redisConfig->connectTimeout); // Required.
-                connectionOpts.socket_timeout = std::chrono::milliseconds(_redisConfig->socketTimeout);   // Required.
-                connectionOpts.db = idx;
-                sw::redis::ConnectionPoolOptions poolOpts;
-                poolOpts.size = _redisConfig->poolSize; // Optional. The default size is 1.
-                redis = std::make_shared<sw::redis::Redis>(_sentinel, _redisConfig->masterName, (_redisConfig->master ? sw::redis::Role::MASTER : sw::redis::Role::SLAVE), connectionOpts, poolOpts);
+                redisPool->usedSize.fetch_sub(1, std::memory_order_relaxed);
+                redisPool->repairSize.fetch_add(1, std::memory_order_relaxed);
+                {
+                    std::lock_guard<std::mutex> lock(_maintainMutex);
+                    _repairQueue.emplace_back(redisPool, slot);
+                }
+                _maintainCond.notify_one();
+                return true;
+            }
+
+            // 本线程没有缓存连接时留在线程缓存中
+            if (_redisConfig->threadCache)
+            {
+                auto &entry = t_redisCache.entries[slot];
+                if (!entry.redis)
+                {
+                    entry.pool = redisPool;
+                    entry.redis = std::move(redis);
+                    return true;
+                }
             }
 
             // 将连接放回连接池
-            auto redisPool = _redisConnPool[idx];
-            std::unique_lock<std::mutex> lock(redisPool->mtx);
-            redisPool->redisQueue.push(redis);
-            redisPool->idleSize++;
-            redisPool->usedSize--;
+            redisPool->Release(std::move(redis));
             return true;
         }
 
-        RedisProxy::RedisProxy(int db)
+        CommandBatcherPtr Redispp::GetBatcher(int db, RedisRole role)
+        {
+            int slot = GetSlot(db, role);
+            if (!_sentinel || slot < 0)
+            {
+                return nullptr;
+            }
+            return GetPool(slot)->batcher;
+        }
+
+        RedisPoolStats Redispp::GetPoolStats(int db, RedisRole role) const
+        {
+            RedisPoolStats stats;
+            int slot = GetSlot(db, role);
+            if (slot < 0 || !_redisPoolReady[slot].load(std::memory_order_acquire))
+            {
+                return stats;
+            }
+
+            auto &redisPool = _redisConnPool[slot];
+            stats.totalSize = redisPool->totalSize.load(std::memory_order_relaxed);
+            stats.usedSize = redisPool->usedSize.load(std::memory_order_relaxed);
+            stats.idleSize = redisPool->idleSize.load(std::memory_order_relaxed);
+            stats.repairSize = redisPool->repairSize.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        RedisConnectionStats Redispp::GetConnectionStats() const
         {
+            RedisConnectionStats stats;
+            bool used[MAX_DB_SIZE] = {};
+            for (int slot = 0; slot < MAX_POOL_COUNT; slot++)
+            {
+                if (!_redisPoolReady[slot].load(std::memory_order_acquire))
+                {
+                    continue;
+                }
+
+                // 等待重连的连接已经丢弃，不计入
+                auto &redisPool = _redisConnPool[slot];
+                int connections = redisPool->totalSize.load(std::memory_order_relaxed) - redisPool->repairSize.load(std::memory_order_relaxed);
+                stats.redisConnections += connections;
+                if (slot >= MAX_DB_SIZE)
+                {
+                    stats.replicaConnections += connections;
+                }
+                used[slot % MAX_DB_SIZE] = true;
+            }
+            stats.dbCount = (int)std::count(used, used + MAX_DB_SIZE, true);
+            stats.sentinelSockets = (int)_sentinelConfigs.size();
+            return stats;
+        }
+
+        RedisProxy::RedisProxy(int db, RedisRole role)
+            : RedisProxy(*Redispp::Instance(), db, role)
+        {
+        }
+
+        RedisProxy::RedisProxy(Redispp &redispp, int db, RedisRole role)
+        {
+            _redispp = &redispp;
             _db = db;
-            _ptr = Redispp::Instance()->GetRedis(db);
+            _role = role;
+            _ptr = _redispp->GetRedis(db, role);
             _isValid = _ptr != nullptr;
+            if (_isValid)
+            {
+                _batcher = _redispp->GetBatcher(db, role);
+            }
         }
 
         RedisProxy::~RedisProxy()
         {
-            Redispp::Instance()->GiveBack(_ptr, _isValid, _db);
+            _redispp->GiveBack(std::move(_ptr), _isValid, _db, _role);
+        }
+
+        sw::redis::ReplyUPtr RedisProxy::Execute(const sw::redis::StringView *first, const sw::redis::StringView *last)
+        {
+            if (!_batcher)
+            {
+                return _ptr->command(first, last);
+            }
+
+            bool broken = false;
+            try
+            {
+                return _batcher->Execute(_ptr, first, last, broken);
+            }
+            catch (...)
+            {
+                // 本线程作为发送者时连接出错，归还时交给后台维护线程重连
+                if (broken)
+                {
+                    _isValid = false;
+                }
+                throw;
+            }
         }
 
         void RedisProxy::SetInvalid()
@@ -0,0 +1,136 @@
+/**
+ * @file script_manager.cpp
+ * @brief lua脚本注册表
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "redispp/script_manager.h"
+
+#include <cstring>
+
+namespace library
+{
+    namespace redis
+    {
+        const char ALLOC_PUSH_SCRIPT_NAME[] = "alloc_push";
+
+        const char ALLOC_PUSH_SCRIPT[] = R"(
+local holder = ARGV[1]
+local count = (#ARGV - 1) / 3
+if count < 1 or count % 1 ~= 0 then
+    return redis.error_reply('ERR alloc_push wrong number of arguments')
+end
+
+local last = tonumber(redis.call('GET', KEYS[1]) or '0') + count
+if #holder > 0 and #string.format('%d', last) > #holder then
+    return redis.error_reply('ERR alloc_push order id wider than placeholder')
+end
+for i = 2, #ARGV, 3 do
+    local idx = tonumber(ARGV[i])
+    if idx == nil or idx < 1 or KEYS[idx + 2] == nil then
+        return redis.error_reply('ERR alloc_push queue index out of range')
+    end
+    if #holder > 0 and not string.find(ARGV[i + 2], holder, 1, true) then
+        return redis.error_reply('ERR alloc_push placeholder not found')
+    end
+end
+
+local id = redis.call('INCRBY', KEYS[1], count) - count
+for i = 2, #ARGV, 3 do
+    id = id + 1
+    local data = ARGV[i + 2]
+    if #holder > 0 then
+        local pos = string.find(data, holder, 1, true)
+        local text = string.format('%d', id)
+        data = string.sub(data, 1, pos - 1) .. text .. string.rep('\0', #holder - #text) .. string.sub(data, pos + #holder)
+    end
+    redis.call('RPUSH', KEYS[tonumber(ARGV[i]) + 2], data)
+    redis.call('HINCRBY', KEYS[2], ARGV[i + 1], 1)
+end
+return id
+)";
+
+        /**
+         * @brief 通过SCRIPT LOAD加载脚本
+         * @param redis redis连接
+         * @param script 脚本
+         * @return std::string SHA1
+         */
+        static std::string LoadSha(RedisProxy &redis, const LuaScript &script)
+        {
+            auto reply = redis.Command("SCRIPT", "LOAD", script.source);
+            return sw::redis::reply::parse<std::string>(*reply);
+        }
+
+        LuaScriptPtr ScriptManager::Register(const std::string &name, const std::string &source)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto &script = _scripts[name];
+            if (!script)
+            {
+                script = std::make_shared<LuaScript>();
+                script->name = name;
+                script->source = source;
+            }
+            return script;
+        }
+
+        LuaScriptPtr ScriptManager::Get(const std::string &name) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto itor = _scripts.find(name);
+            return itor == _scripts.end() ? nullptr : itor->second;
+        }
+
+        void ScriptManager::Load(RedisProxy &redis, LuaScript &script)
+        {
+            auto sha = LoadSha(redis, script);
+            std::call_once(script.loadOnce, [&]
+                           { script.sha = std::move(sha); });
+        }
+
+        sw::redis::ReplyUPtr ScriptManager::Eval(RedisProxy &redis, LuaScript &script,
+                                                 const std::vector<sw::redis::StringView> &keys,
+                                                 const std::vector<sw::redis::StringView> &args)
+        {
+            // SHA1只由脚本内容决定，首次加载后不再修改，可以无锁读取
+            std::call_once(script.loadOnce, [&]
+                           { script.sha = LoadSha(redis, script); });
+
+            // 参数表按线程复用，逐条调用时不再每次分配
+            thread_local std::vector<sw::redis::StringView> argv;
+            auto numKeys = std::to_string(keys.size());
+            argv.clear();
+            argv.emplace_back("EVALSHA");
+            argv.emplace_back(script.sha);
+            argv.emplace_back(numKeys);
+            argv.insert(argv.end(), keys.begin(), keys.end());
+            argv.insert(argv.end(), args.begin(), args.end());
+
+            try
+            {
+                return redis.Command(argv);
+            }
+            catch (const sw::redis::ReplyError &e)
+            {
+                // 主从切换或SCRIPT FLUSH后脚本缓存为空，NOSCRIPT时脚本未执行，重新加载后重试是安全的
+                if (strncmp(e.what(), "NOSCRIPT", 8) != 0)
+                {
+                    throw;
+                }
+            }
+
+            _reloadCount.fetch_add(1, std::memory_order_relaxed);
+            LoadSha(redis, script);
+            return redis.Command(argv);
+        }
+    } // namespace redis
+} // namespace library
@@ -0,0 +1,264 @@
+/**
+ * @file fixed_point.h
+ * @brief 定点小数，以int64按10^N倍缩放存储，用于价格和金额的精确计算
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace library
+{
+    namespace utils
+    {
+        /**
+         * @brief 定点小数
+         * 内部保存 值 * 10^DECIMALS 的int64整数，加减及与整数的乘除均为整数运算，没有浮点误差；
+         * 只在系统边界（配置、行情、展示）与double或字符串相互转换。
+         * @tparam DECIMALS 小数位数
+         */
+        template <int DECIMALS>
+        class FixedPoint
+        {
+        public:
+            static_assert(DECIMALS > 0 && DECIMALS < 10, "unsupported decimals");
+
+            /**
+             * @brief 缩放倍数 10^DECIMALS
+             */
+            static constexpr int64_t SCALE = []
+            {
+                int64_t scale = 1;
+                for (int i = 0; i < DECIMALS; i++)
+                {
+                    scale *= 10;
+                }
+                return scale;
+            }();
+
+            constexpr FixedPoint()
+                : _raw(0)
+            {
+            }
+
+            /**
+             * @brief 由缩放后的整数构造，例如DECIMALS=4时FromRaw(42600)表示4.26
+             * @param raw 缩放后的整数
+             * @return FixedPoint 定点数
+             */
+            static constexpr FixedPoint FromRaw(int64_t raw)
+            {
+                FixedPoint v;
+                v._raw = raw;
+                return v;
+            }
+
+            /**
+             * @brief 由整数构造
+             * @param value 整数值
+             * @return FixedPoint 定点数
+             */
+            static constexpr FixedPoint FromInt(int64_t value) { return FromRaw(value * SCALE); }
+
+            /**
+             * @brief 由double构造，四舍五入到DECIMALS位小数
+             * @param value 浮点值
+             * @return FixedPoint 定点数
+             */
+            static FixedPoint FromDouble(double value) { return FromRaw(std::llround(value * SCALE)); }
+
+            /**
+             * @brief 解析十进制字符串，如"-12.3456"，小数位数超过DECIMALS或格式错误时失败
+             * @param str 字符串
+             * @param len 字符串长度
+             * @param value 输出的定点数
+             * @return true 成功
+             * @return false 失败
+             */
+            static bool Parse(const char *str, size_t len, FixedPoint &value)
+            {
+                const char *p = str;
+                const char *end = str + len;
+                bool negative = false;
+                if (p < end && (*p == '-' || *p == '+'))
+                {
+                    negative = *p == '-';
+                    ++p;
+                }
+
+                int64_t intPart = 0;
+                auto res = std::from_chars(p, end, intPart);
+                if (res.ec != std::errc() || intPart < 0 || intPart > INT64_MAX / SCALE - 1)
+                {
+                    return false;
+                }
+                p = res.ptr;
+
+                int64_t fracPart = 0;
+                int digits = 0;
+                if (p < end && *p == '.')
+                {
+                    for (++p; p < end; ++p, ++digits)
+                    {
+                        if (*p < '0' || *p > '9' || digits >= DECIMALS)
+                        {
+                            return false;
+                        }
+                        fracPart = fracPart * 10 + (*p - '0');
+                    }
+                }
+                if (p != end)
+                {
+                    return false;
+                }
+
+                for (; digits < DECIMALS; digits++)
+                {
+                    fracPart *= 10;
+                }
+
+                int64_t raw = intPart * SCALE + fracPart;
+                value = FromRaw(negative ? -raw : raw);
+                return true;
+            }
+
+            /**
+             * @brief 解析十进制字符串
+             * @param str 字符串
+             * @param value 输出的定点数
+             * @return true 成功
+             * @return false 失败
+             */
+            static bool Parse(const std::string &str, FixedPoint &value) { return Parse(str.data(), str.size(), value); }
+
+            /**
+             * @brief 获取缩放后的整数
+             * @return int64_t 缩放后的整数
+             */
+            constexpr int64_t Raw() const { return _raw; }
+
+            /**
+             * @brief 转换为double，只用于展示或对外接口
+             * @return double 浮点值
+             */
+            constexpr double ToDouble() const { return (double)_raw / SCALE; }
+
+            /**
+             * @brief 格式化为十进制字符串，不分配内存，去掉小数末尾的0，如4.2600输出"4.26"，5.0000输出"5"
+             * @param first 输出缓冲区起始
+             * @param last 输出缓冲区结束，长度不少于24字节时一定成功
+             * @return char* 输出结束位置，缓冲区不足时返回first
+             */
+            char *ToChars(char *first, char *last) const
+            {
+                // 绝对值使用uint64，避免INT64_MIN取反溢出
+                uint64_t abs = _raw < 0 ? 0 - (uint64_t)_raw : (uint64_t)_raw;
+                char *p = first;
+                if (_raw < 0)
+                {
+                    if (p == last)
+                    {
+                        return first;
+                    }
+                    *p++ = '-';
+                }
+
+                auto res = std::to_chars(p, last, abs / SCALE);
+                if (res.ec != std::errc())
+                {
+                    return first;
+                }
+                p = res.ptr;
+
+                uint64_t frac = abs % SCALE;
+                if (frac == 0)
+                {
+                    return p;
+                }
+
+                int digits = DECIMALS;
+                while (frac % 10 == 0)
+                {
+                    frac /= 10;
+                    --digits;
+                }
+                if (last - p < digits + 1)
+                {
+                    return first;
+                }
+
+                *p++ = '.';
+                for (int i = digits - 1; i >= 0; i--)
+                {
+                    p[i] = (char)('0' + frac % 10);
+                    frac /= 10;
+                }
+                return p + digits;
+            }
+
+            /**
+             * @brief 格式化为十进制字符串
+             * @return std::string 字符串表示
+             */
+            std::string ToString() const
+            {
+                char buf[32];
+                return std::string(buf, ToChars(buf, buf + sizeof(buf)));
+            }
+
+            // 算术运算，与整数的乘除用于 价格*数量、金额/数量 等场景
+            constexpr FixedPoint operator+(FixedPoint v) const { return FromRaw(_raw + v._raw); }
+            constexpr FixedPoint operator-(FixedPoint v) const { return FromRaw(_raw - v._raw); }
+            constexpr FixedPoint operator-() const { return FromRaw(-_raw); }
+            constexpr FixedPoint operator*(int64_t n) const { return FromRaw(_raw * n); }
+            constexpr FixedPoint operator/(int64_t n) const { return FromRaw(_raw / n); }
+            constexpr FixedPoint &operator+=(FixedPoint v)
+            {
+                _raw += v._raw;
+                return *this;
+            }
+            constexpr FixedPoint &operator-=(FixedPoint v)
+            {
+                _raw -= v._raw;
+                return *this;
+            }
+
+            // 比较运算
+            constexpr bool operator==(FixedPoint v) const { return _raw == v._raw; }
+            constexpr bool operator!=(FixedPoint v) const { return _raw != v._raw; }
+            constexpr bool operator<(FixedPoint v) const { return _raw < v._raw; }
+            constexpr bool operator<=(FixedPoint v) const { return _raw <= v._raw; }
+            constexpr bool operator>(FixedPoint v) const { return _raw > v._raw; }
+            constexpr bool operator>=(FixedPoint v) const { return _raw >= v._raw; }
+
+        private:
+            int64_t _raw; // 值 * SCALE
+        };
+
+        template <int DECIMALS>
+        constexpr FixedPoint<DECIMALS> operator*(int64_t n, FixedPoint<DECIMALS> v)
+        {
+            return v * n;
+        }
+
+        template <int DECIMALS>
+        std::ostream &operator<<(std::ostream &out, FixedPoint<DECIMALS> v)
+        {
+            char buf[32];
+            return out.write(buf, v.ToChars(buf, buf + sizeof(buf)) - buf);
+        }
+    } // namespace utils
+} // namespace library
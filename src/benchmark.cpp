@@ -0,0 +1,698 @@
+/**
+ * @file benchmark.cpp
+ * @brief 不依赖redis的本地性能测试
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common_def.h"
+#include "fmt/format.h"
+#include "freeze_engine.h"
+#include "fund_ledger.h"
+#include "matching_engine.h"
+#include "order_codec.h"
+#include "order_store.h"
+#include "order_workload.h"
+#include "redispp/redispp.h"
+#include "utils/time_utils.h"
+
+/**
+ * @brief 生成第i笔测试订单，每4笔中有1笔带有成交回报字段和说明，其余为新订单
+ * @param i 序号
+ * @param order 输出的订单
+ */
+static void MakeSampleOrder(int64_t i, Order& order) {
+    order = Order{};
+    order.branch_no = 30;
+    fmt::format_to_n(order.client_id, sizeof(order.client_id) - 1, "{}", CLIENT_ID_BASE + i % 1000);
+    fmt::format_to_n(order.fund_account, sizeof(order.fund_account) - 1, "{}", FUND_ACCOUNT_BASE + i % 1000);
+    strcpy(order.password, "abc123");
+    fmt::format_to_n(order.order_id, sizeof(order.order_id) - 1, "{}", i + 1);
+    strcpy(order.stock_account, "B880820006");
+    order.exchange_type = '1';
+    fmt::format_to_n(order.stock_code, sizeof(order.stock_code) - 1, "{}", 600000 + i % 50);
+    order.op_entrust_way = '1';
+    order.entrust_prop = '0';
+    order.entrust_bs = i % 2 ? '1' : '2';
+    order.entrust_amount = 100 * (1 + i % 10);
+    order.entrust_price = Price::FromRaw(42600 + (i % 20) * 100);
+    order.registe_sure_flag = '1';
+
+    if (i % 4 == 0) {
+        order.init_date = 20261017;
+        order.entrust_time = 93000 + (int32_t)(i % 3000);
+        order.entrust_no = (int32_t)i;
+        order.report_no = -(int32_t)i;
+        strcpy(order.seat_no, "12345");
+        order.deal_price = order.entrust_price;
+        order.deal_amount = order.entrust_amount;
+        order.entrust_status = '8';
+        order.fees = Money::FromInt(5);
+        order.freeze_money = order.entrust_price * order.entrust_amount;
+        order.update_time = order.entrust_time;
+        strcpy(order.remark, "全部成交");
+        order.send_time = 1792224000000000000LL + i;
+    }
+}
+
+/**
+ * @brief 逐字段比较两笔订单
+ */
+static bool SameOrder(const Order& a, const Order& b) {
+#define SAME_VALUE(name) (a.name == b.name)
+#define SAME_STR(name) (strncmp(a.name, b.name, sizeof(a.name)) == 0)
+    return SAME_VALUE(branch_no) && SAME_STR(client_id) && SAME_STR(fund_account) && SAME_STR(password) && SAME_STR(order_id) &&
+           SAME_VALUE(batch_no) && SAME_STR(stock_account) && SAME_VALUE(exchange_type) && SAME_STR(stock_code) &&
+           SAME_VALUE(op_entrust_way) && SAME_VALUE(entrust_prop) && SAME_VALUE(entrust_bs) && SAME_VALUE(entrust_amount) &&
+           SAME_VALUE(entrust_price) && SAME_VALUE(entrust_money) && SAME_VALUE(registe_sure_flag) && SAME_VALUE(init_date) &&
+           SAME_VALUE(entrust_time) && SAME_VALUE(entrust_no) && SAME_VALUE(report_no) && SAME_STR(seat_no) &&
+           SAME_VALUE(deal_price) && SAME_VALUE(deal_amount) && SAME_VALUE(cancel_amount) && SAME_VALUE(entrust_status) &&
+           SAME_VALUE(fees) && SAME_VALUE(freeze_money) && SAME_VALUE(update_time) && SAME_STR(remark) &&
+           SAME_VALUE(send_time);
+#undef SAME_VALUE
+#undef SAME_STR
+}
+
+/**
+ * @brief 订单编码测试：校验编码/解码往返一致，统计编码长度和编解码耗时
+ */
+static int BenchCodec(int64_t count) {
+    const int64_t SAMPLE_COUNT = 1024;
+    std::vector<Order> orders(SAMPLE_COUNT);
+    std::vector<char> encoded(SAMPLE_COUNT * OrderCodec::MAX_ENCODED_SIZE);
+    std::vector<size_t> sizes(SAMPLE_COUNT);
+    for (int64_t i = 0; i < SAMPLE_COUNT; i++) {
+        MakeSampleOrder(i, orders[i]);
+    }
+
+    // 往返校验，包括截断数据和缓冲区不足时必须失败
+    size_t totalBytes = 0;
+    for (int64_t i = 0; i < SAMPLE_COUNT; i++) {
+        char* buf = &encoded[i * OrderCodec::MAX_ENCODED_SIZE];
+        sizes[i] = OrderCodec::Encode(orders[i], buf, OrderCodec::MAX_ENCODED_SIZE);
+        totalBytes += sizes[i];
+
+        Order decoded;
+        if (sizes[i] == 0 || !OrderCodec::Decode(buf, sizes[i], decoded) || !SameOrder(orders[i], decoded)) {
+            std::cout << "订单编码往返校验失败，序号:" << i << std::endl;
+            return -1;
+        }
+        if (OrderCodec::Decode(buf, sizes[i] - 1, decoded) || OrderCodec::Encode(orders[i], buf, sizes[i] - 1) != 0) {
+            std::cout << "订单编码截断校验失败，序号:" << i << std::endl;
+            return -1;
+        }
+        OrderCodec::Encode(orders[i], buf, OrderCodec::MAX_ENCODED_SIZE);
+    }
+
+    // 带版本消息头的原始结构可以往返，不带消息头的旧原始结构必须拒绝
+    Order raw;
+    char rawBuf[OrderCodec::RAW_MESSAGE_SIZE];
+    auto rawSize = OrderCodec::EncodeRaw(orders[1], rawBuf, sizeof(rawBuf));
+    if (rawSize == 0 || !OrderCodec::DecodeMessage(rawBuf, rawSize, raw) || !SameOrder(orders[1], raw) ||
+        OrderCodec::DecodeMessage((const char*)&orders[1], sizeof(Order), raw)) {
+        std::cout << "原始结构校验失败" << std::endl;
+        return -1;
+    }
+
+    auto cyclesPerNs = library::utils::Time::GetCyclesPerSec() / 1e9;
+    char buf[OrderCodec::MAX_ENCODED_SIZE];
+    size_t sink = 0;
+    auto start = library::utils::Time::Rdtsc();
+    for (int64_t i = 0; i < count; i++) {
+        sink += OrderCodec::Encode(orders[i % SAMPLE_COUNT], buf, sizeof(buf));
+    }
+    auto encodeNs = (library::utils::Time::Rdtsc() - start) / cyclesPerNs / count;
+
+    Order decoded;
+    start = library::utils::Time::Rdtsc();
+    for (int64_t i = 0; i < count; i++) {
+        auto idx = i % SAMPLE_COUNT;
+        sink += OrderCodec::Decode(&encoded[idx * OrderCodec::MAX_ENCODED_SIZE], sizes[idx], decoded);
+    }
+    auto decodeNs = (library::utils::Time::Rdtsc() - start) / cyclesPerNs / count;
+
+    double avgBytes = (double)totalBytes / SAMPLE_COUNT;
+    std::cout << fmt::format("codec: 往返校验{}笔通过, 原始结构{}字节, 平均编码{:.1f}字节, 压缩比{:.1f}x", SAMPLE_COUNT, sizeof(Order), avgBytes,
+                             sizeof(Order) / avgBytes)
+              << std::endl;
+    std::cout << fmt::format("codec: 次数{}, 编码{:.1f}ns/笔, 解码{:.1f}ns/笔 (校验和{})", count, encodeNs, decodeNs, sink) << std::endl;
+    return 0;
+}
+
+/**
+ * @brief 冷热分离测试：校验与Order相互转换一致，比较按Order数组和按OrderCore数组扫描的吞吐量
+ * 扫描统计买入且未撤单订单的委托金额合计，模拟风控/撮合对全部订单的遍历
+ */
+static int BenchLayout(int64_t count) {
+    std::vector<Order> orders(count);
+    OrderStore store;
+    store.Reserve(count);
+    for (int64_t i = 0; i < count; i++) {
+        MakeSampleOrder(i, orders[i]);
+        store.Add(orders[i]);
+    }
+
+    Order loaded;
+    for (int64_t i = 0; i < count; i++) {
+        store.Load((uint32_t)i, loaded);
+        if (!SameOrder(orders[i], loaded)) {
+            std::cout << "冷热分离转换校验失败，序号:" << i << std::endl;
+            return -1;
+        }
+    }
+
+    // 扫描总笔数不少于2000万，数据量小时多扫几遍
+    const int64_t passes = std::max<int64_t>(1, 20000000 / count);
+    auto cyclesPerNs = library::utils::Time::GetCyclesPerSec() / 1e9;
+
+    int64_t orderSum = 0;
+    auto start = library::utils::Time::Rdtsc();
+    for (int64_t pass = 0; pass < passes; pass++) {
+        for (const auto& order : orders) {
+            if (order.entrust_bs == '1' && order.entrust_status != '6') {
+                orderSum += (order.entrust_price * order.entrust_amount).Raw();
+            }
+        }
+    }
+    auto orderNs = (library::utils::Time::Rdtsc() - start) / cyclesPerNs / (count * passes);
+
+    int64_t coreSum = 0;
+    start = library::utils::Time::Rdtsc();
+    for (int64_t pass = 0; pass < passes; pass++) {
+        for (const auto& core : store.Cores()) {
+            if (core.entrust_bs == '1' && core.entrust_status != '6') {
+                coreSum += (core.entrust_price * core.entrust_amount).Raw();
+            }
+        }
+    }
+    auto coreNs = (library::utils::Time::Rdtsc() - start) / cyclesPerNs / (count * passes);
+
+    if (orderSum != coreSum) {
+        std::cout << "冷热分离扫描结果不一致: " << orderSum << " != " << coreSum << std::endl;
+        return -1;
+    }
+
+    std::cout << fmt::format("layout: 订单{}笔, 扫描{}遍, Order {}字节 {:.2f}ns/笔 {:.0f}万笔/秒, OrderCore {}字节 {:.2f}ns/笔 {:.0f}万笔/秒, 提升{:.1f}x",
+                             count, passes, sizeof(Order), orderNs, 1e5 / orderNs, sizeof(OrderCore), coreNs, 1e5 / coreNs,
+                             orderNs / coreNs)
+              << std::endl;
+    return 0;
+}
+
+/**
+ * @brief 资金账本测试：新增账户、随机查询的耗时，以及重新打开后数据是否保留和打开耗时
+ */
+static int BenchLedger(int64_t count) {
+    if (count > ACCOUNT_MAX) {
+        std::cout << "账户数不能超过" << ACCOUNT_MAX << std::endl;
+        return -1;
+    }
+
+    const std::string path = "bench_fund_ledger.dat";
+    std::remove(path.c_str());
+
+    auto cyclesPerNs = library::utils::Time::GetCyclesPerSec() / 1e9;
+    double addNs = 0;
+    double findNs = 0;
+    int64_t sink = 0;
+    {
+        FundLedger ledger(path, (uint32_t)count);
+        auto start = library::utils::Time::Rdtsc();
+        for (int64_t i = 0; i < count; i++) {
+            auto id = ledger.FindOrAdd(FUND_ACCOUNT_BASE + i);
+            if (id != i) {
+                std::cout << "账户序号分配错误，序号:" << i << " 实际:" << id << std::endl;
+                return -1;
+            }
+            ledger.Slot(id).fund.fund_avl = Money::FromInt(1000000 + i);
+        }
+        addNs = (library::utils::Time::Rdtsc() - start) / cyclesPerNs / count;
+
+        if (ledger.FindOrAdd(FUND_ACCOUNT_BASE + count) != -1 || ledger.Find(FUND_ACCOUNT_BASE + count) != -1) {
+            std::cout << "账本已满时应拒绝新账户" << std::endl;
+            return -1;
+        }
+
+        uint64_t seed = 88172645463325252ULL;
+        start = library::utils::Time::Rdtsc();
+        for (int64_t i = 0; i < count; i++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            auto id = ledger.Find(FUND_ACCOUNT_BASE + (int64_t)(seed % count));
+            sink += ledger.Slot(id).fund.fund_avl.Raw();
+        }
+        findNs = (library::utils::Time::Rdtsc() - start) / cyclesPerNs / count;
+    }
+
+    // 重新打开，数据必须保留
+    auto start = library::utils::Time::Rdtsc();
+    FundLedger ledger(path, (uint32_t)count);
+    auto openUs = (library::utils::Time::Rdtsc() - start) / cyclesPerNs / 1000;
+    if (ledger.Size() != count) {
+        std::cout << "重新打开后账户数不一致: " << ledger.Size() << std::endl;
+        return -1;
+    }
+    for (int64_t i = 0; i < count; i++) {
+        auto id = ledger.Find(FUND_ACCOUNT_BASE + i);
+        if (id != i || ledger.Slot(id).fund.fund_avl != Money::FromInt(1000000 + i)) {
+            std::cout << "重新打开后账户数据不一致，序号:" << i << std::endl;
+            return -1;
+        }
+    }
+    std::remove(path.c_str());
+
+    std::cout << fmt::format("ledger: 账户{}个, 新增{:.1f}ns/个, 随机查询{:.1f}ns/次, 重新打开{:.1f}us (校验和{})", count, addNs, findNs, openUs,
+                             sink)
+              << std::endl;
+    return 0;
+}
+
+/**
+ * @brief 冻结引擎测试：多线程争抢同一账户时不透支；各线程在accountCount个账户上随机冻结+解冻，账户越少争用越激烈
+ * @param count 每个线程的冻结次数
+ * @param threads 线程数
+ * @param accountCount 账户数量
+ * @param workload 订单分布，不为空时按其账户分布选择账户（热点账户争用），为空时均匀选择
+ */
+static int BenchFreeze(int64_t count, int64_t threads, int64_t accountCount, const WorkloadProfile* workload) {
+    threads = std::max<int64_t>(threads, 1);
+    accountCount = std::max<int64_t>(accountCount, 1);
+    if (accountCount > ACCOUNT_MAX) {
+        std::cout << "账户数不能超过" << ACCOUNT_MAX << std::endl;
+        return -1;
+    }
+
+    const std::string path = "bench_freeze_ledger.dat";
+    std::remove(path.c_str());
+    FundLedger ledger(path, (uint32_t)accountCount);
+    FreezeEngine engine(ledger);
+    for (int64_t i = 0; i < accountCount; i++) {
+        ledger.FindOrAdd(FUND_ACCOUNT_BASE + i);
+    }
+
+    // 同一账户只够冻结count次，全部线程合计必须恰好成功count次
+    const Money UNIT = Money::FromRaw(42600 * 300);
+    engine.Reset(0, UNIT * count);
+    std::vector<std::thread> workers;
+    std::vector<int64_t> succeeded(threads);
+    for (int64_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (int64_t i = 0; i < count; i++) {
+                succeeded[t] += engine.Freeze(0, UNIT);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    int64_t total = 0;
+    for (auto n : succeeded) {
+        total += n;
+    }
+    auto fund = engine.Get(0);
+    if (total != count || fund.fund_avl != Money() || fund.fund_trd_frz != UNIT * count) {
+        std::cout << "冻结争用校验失败: 成功" << total << "次, 可用" << fund.fund_avl << ", 冻结" << fund.fund_trd_frz << std::endl;
+        return -1;
+    }
+
+    const Money INIT_FUND = Money::FromInt(1000000000);
+    for (int64_t i = 0; i < accountCount; i++) {
+        engine.Reset((int32_t)i, INIT_FUND);
+    }
+
+    // 按订单分布选择账户时预先生成账户序号，抽样耗时不计入冻结耗时
+    std::vector<std::vector<int32_t>> accountIds(workload ? threads : 0);
+    if (workload) {
+        OrderWorkload generator(*workload, accountCount);
+        for (int64_t t = 0; t < threads; t++) {
+            accountIds[t].resize(count);
+            for (int64_t i = 0; i < count; i++) {
+                accountIds[t][i] = (int32_t)generator.AccountIndex(t * count + i);
+            }
+        }
+    }
+
+    std::atomic<bool> go{false};
+    std::vector<double> elapsedNs(threads);
+    auto cyclesPerNs = library::utils::Time::GetCyclesPerSec() / 1e9;
+    for (int64_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            uint64_t seed = 88172645463325252ULL + t;
+            const int32_t* ids = workload ? accountIds[t].data() : nullptr;
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            auto start = library::utils::Time::Rdtsc();
+            for (int64_t i = 0; i < count; i++) {
+                seed ^= seed << 13;
+                seed ^= seed >> 7;
+                seed ^= seed << 17;
+                auto id = ids ? ids[i] : (int32_t)(seed % accountCount);
+                engine.Freeze(id, UNIT);
+                engine.Unfreeze(id, UNIT);
+            }
+            elapsedNs[t] = (library::utils::Time::Rdtsc() - start) / cyclesPerNs;
+        });
+    }
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (int64_t i = 0; i < accountCount; i++) {
+        fund = engine.Get((int32_t)i);
+        if (fund.fund_avl != INIT_FUND || fund.fund_trd_frz != Money()) {
+            std::cout << "冻结解冻后资金不一致，账户序号:" << i << std::endl;
+            return -1;
+        }
+    }
+    std::remove(path.c_str());
+
+    double maxNs = *std::max_element(elapsedNs.begin(), elapsedNs.end());
+    std::cout << fmt::format("freeze: 线程{}, 账户{}({}), 每线程{}次冻结+解冻, {:.1f}ns/次, 合计{:.0f}万次/秒", threads, accountCount,
+                             workload ? "按订单分布" : "均匀", count, maxNs / count, threads * count / maxNs * 1e5)
+              << std::endl;
+    return 0;
+}
+
+/**
+ * @brief 订单簿价格优先、时间优先及成交回填校验，撮合引擎不以非法价格建簿
+ */
+static bool CheckOrderBook() {
+    OrderBook book(Price::FromRaw(42600));
+    std::vector<Fill> fills;
+    FillHandler onFill = [&fills](const Fill& fill) { fills.push_back(fill); };
+
+    Order order{};
+    auto place = [&](int32_t no, char bs, int64_t priceRaw, int32_t amount) {
+        order.entrust_bs = bs;
+        order.entrust_price = Price::FromRaw(priceRaw);
+        order.entrust_amount = amount;
+        return book.Match(order, no, onFill);
+    };
+
+    // 卖1: 300@4.26 卖2: 100@4.26 卖3: 200@4.25，买4: 400@4.26先吃4.25再按时间吃卖1
+    place(1, '2', 42600, 300);
+    place(2, '2', 42600, 100);
+    place(3, '2', 42500, 200);
+    if (book.BestAsk() != Price::FromRaw(42500) || book.LevelAmount('2', Price::FromRaw(42600)) != 400) {
+        return false;
+    }
+    place(4, '1', 42600, 400);
+    if (fills.size() != 2 || fills[0].makerNo != 3 || fills[0].amount != 200 || fills[1].makerNo != 1 || fills[1].amount != 200 ||
+        order.entrust_status != ENTRUST_STATUS_FILLED || order.deal_amount != 400 || order.deal_price != Price::FromRaw(42550)) {
+        return false;
+    }
+
+    // 买5: 500@4.27，吃掉卖1剩余100和卖2的100，剩余300挂在4.27
+    fills.clear();
+    place(5, '1', 42700, 500);
+    if (fills.size() != 2 || fills[0].makerNo != 1 || fills[1].makerNo != 2 || order.entrust_status != ENTRUST_STATUS_PARTIAL ||
+        order.deal_amount != 200 || book.BestBid() != Price::FromRaw(42700) || book.BestAsk() != Price()) {
+        return false;
+    }
+
+    // 价格不在最小变动单位上或超出涨跌幅为废单
+    if (!(!place(6, '1', 42601, 100) && order.entrust_status == ENTRUST_STATUS_INVALID && !place(7, '2', 60000, 100) &&
+          place(8, '2', 42800, 100) && order.entrust_status == ENTRUST_STATUS_REPORTED)) {
+        return false;
+    }
+
+    // 首笔委托价格非法时不建订单簿，之后的合法委托仍能建簿
+    MatchingEngine engine;
+    MakeSampleOrder(1, order);
+    order.entrust_price = Price();
+    if (engine.Match(order) || engine.BookCount() != 0) {
+        return false;
+    }
+    order.entrust_price = Price::FromRaw(42601);
+    if (engine.Match(order) || engine.BookCount() != 0) {
+        return false;
+    }
+    order.entrust_price = Price::FromRaw(42600);
+    return engine.Match(order) && engine.BookCount() == 1;
+}
+
+/**
+ * @brief 撮合测试：默认单只证券，委托价格在4.26上下10档随机，买卖各半，统计每笔委托的撮合延迟
+ * @param count 委托笔数
+ * @param workload 订单分布，不为空时证券、买卖方向、数量和价格按其生成
+ */
+static int BenchMatch(int64_t count, const WorkloadProfile* workload) {
+    if (!CheckOrderBook()) {
+        std::cout << "订单簿撮合校验失败" << std::endl;
+        return -1;
+    }
+
+    int64_t fillCount = 0;
+    MatchingEngine engine([&fillCount](const Fill&) { ++fillCount; });
+    std::vector<uint64_t> cycles(count);
+
+    Order order;
+    MakeSampleOrder(1, order);
+    std::unique_ptr<OrderWorkload> generator(workload ? new OrderWorkload(*workload, 1000) : nullptr);
+    uint64_t seed = 88172645463325252ULL;
+    auto start = library::utils::Time::Rdtsc();
+    for (int64_t i = 0; i < count; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        if (generator) {
+            generator->Fill(i, order);
+        } else {
+            order.entrust_bs = seed & 1 ? '1' : '2';
+            order.entrust_price = Price::FromRaw(42600 + ((int64_t)(seed >> 8) % 21 - 10) * OrderBook::TICK_RAW);
+            order.entrust_amount = 100 * (1 + (int32_t)((seed >> 16) % 10));
+        }
+
+        auto begin = library::utils::Time::Rdtsc();
+        engine.Match(order);
+        cycles[i] = library::utils::Time::Rdtsc() - begin;
+    }
+    auto totalNs = (library::utils::Time::Rdtsc() - start) / (library::utils::Time::GetCyclesPerSec() / 1e9);
+
+    std::sort(cycles.begin(), cycles.end());
+    auto cyclesPerNs = library::utils::Time::GetCyclesPerSec() / 1e9;
+    auto percentile = [&](double p) { return cycles[std::min<int64_t>(count - 1, (int64_t)(count * p))] / cyclesPerNs; };
+    std::cout << fmt::format("match: 证券{}只, 委托{}笔, 成交{}次, 延迟p50 {:.0f}ns p99 {:.0f}ns max {:.0f}ns, 委托{:.0f}万笔/秒, 成交{:.0f}万次/秒",
+                             engine.BookCount(), count, fillCount, percentile(0.5), percentile(0.99), cycles.back() / cyclesPerNs, count / totalNs * 1e5,
+                             fillCount / totalNs * 1e5)
+              << std::endl;
+    return 0;
+}
+
+// 原有的互斥锁连接池，只保留取出/归还路径，作为对比基准
+struct MutexRedisPool {
+    int usedSize = 0;                                    // 已经使用的连接数
+    int idleSize = 0;                                    // 闲置的连接数
+    std::mutex mtx;                                      // 连接池锁
+    std::queue<library::redis::RedisPtr> redisQueue;     // redis连接队列
+
+    library::redis::RedisPtr Get() {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (redisQueue.empty()) {
+            return nullptr;
+        }
+        auto redis = redisQueue.front();
+        redisQueue.pop();
+        usedSize++;
+        idleSize--;
+        return redis;
+    }
+
+    void GiveBack(library::redis::RedisPtr redis) {
+        std::unique_lock<std::mutex> lock(mtx);
+        redisQueue.push(redis);
+        idleSize++;
+        usedSize--;
+    }
+};
+
+/**
+ * @brief 多线程同时取出/归还连接，返回全部线程合计每秒取出+归还的次数，取不到连接的次数累加到misses
+ */
+template <typename Get, typename GiveBack>
+static double RunPoolThreads(int64_t count, int64_t threads, Get get, GiveBack giveBack, std::atomic<int64_t>& misses) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int64_t t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            int64_t miss = 0;
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int64_t i = 0; i < count; i++) {
+                auto redis = get();
+                if (!redis) {
+                    ++miss;
+                    continue;
+                }
+                giveBack(std::move(redis));
+            }
+            misses += miss;
+        });
+    }
+    auto start = library::utils::Time::Rdtsc();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto seconds = (library::utils::Time::Rdtsc() - start) / library::utils::Time::GetCyclesPerSec();
+    return count * threads / seconds;
+}
+
+/**
+ * @brief 连接池测试：threads个线程反复取出/归还连接，对比原有的互斥锁队列、无锁环形队列、无锁环形队列+线程缓存。
+ * 连接对象不访问网络（redis++按需建立连接），因此不需要redis服务
+ */
+static int BenchPool(int64_t count, int64_t threads) {
+    threads = std::max<int64_t>(threads, 1);
+    auto redisPp = library::redis::Redispp::Instance();
+    auto init = [&](bool threadCache) {
+        library::redis::SentinelConfigArray sentinels;
+        sentinels.push_back(std::make_shared<library::redis::SentinelConfig>());
+        sentinels.back()->host = "127.0.0.1";
+        sentinels.back()->port = 26379;
+        auto config = std::make_shared<library::redis::RedisConfig>();
+        config->masterName = "mymaster";
+        config->master = true;
+        config->db = 0;
+        config->connectTimeout = 100;
+        config->socketTimeout = 100;
+        config->poolSize = (int)threads;
+        config->threadCache = threadCache;
+        config->warmUp = false;
+        redisPp->Init(sentinels, config);
+    };
+
+    // 原有实现：连接预先放入队列，只测量加锁取出/归还
+    init(false);
+    MutexRedisPool mutexPool;
+    for (int64_t i = 0; i < threads; i++) {
+        mutexPool.redisQueue.push(redisPp->GetRedis());
+        mutexPool.idleSize++;
+    }
+    std::atomic<int64_t> mutexMisses{0};
+    auto mutexOps = RunPoolThreads(
+        count, threads, [&] { return mutexPool.Get(); }, [&](library::redis::RedisPtr redis) { mutexPool.GiveBack(redis); }, mutexMisses);
+
+    std::string result = fmt::format("pool: 线程{}, 每线程{}次取出+归还, 互斥锁队列{:.0f}万次/秒", threads, count, mutexOps / 1e4);
+    for (bool threadCache : {false, true}) {
+        init(threadCache);
+        std::atomic<int64_t> misses{0};
+        auto ops = RunPoolThreads(
+            count, threads, [&] { return redisPp->GetRedis(); },
+            [&](library::redis::RedisPtr redis) { redisPp->GiveBack(std::move(redis)); }, misses);
+
+        // 线程退出后缓存的连接已放回连接池，全部连接都应闲置
+        auto stats = redisPp->GetPoolStats();
+        if (stats.usedSize != 0 || stats.idleSize != stats.totalSize || stats.totalSize > threads * 5) {
+            std::cout << fmt::format("连接池计数错误: 总数{} 使用{} 闲置{}", stats.totalSize, stats.usedSize, stats.idleSize) << std::endl;
+            return -1;
+        }
+        result += fmt::format(", {}{:.0f}万次/秒(连接{}个, 未取到{}次)", threadCache ? "无锁队列+线程缓存" : "无锁队列", ops / 1e4,
+                              stats.totalSize, misses.load());
+    }
+    std::cout << result << std::endl;
+    return 0;
+}
+
+/**
+ * @brief 订单生成测试：统计逐笔生成的耗时及账户、证券、买卖方向、数量的实际分布，用于核对分布配置
+ * @param count 订单笔数
+ * @param accountCount 账户数量
+ * @param workload 订单分布，为空时使用默认分布
+ */
+static int BenchWorkload(int64_t count, int64_t accountCount, const WorkloadProfile* workload) {
+    OrderWorkload generator(workload ? *workload : WorkloadProfile(), accountCount);
+    accountCount = generator.GetAccountCount();
+
+    std::vector<int64_t> accountHits(accountCount);
+    std::unordered_map<std::string, int64_t> symbolHits;
+    int64_t buyCount = 0;
+    int64_t amountSum = 0;
+    double genNs = 0;
+    auto cyclesPerNs = library::utils::Time::GetCyclesPerSec() / 1e9;
+
+    Order order;
+    MakeSampleOrder(0, order);
+    for (int64_t i = 0; i < count; i++) {
+        auto begin = library::utils::Time::Rdtsc();
+        generator.Fill(i, order);
+        genNs += (library::utils::Time::Rdtsc() - begin) / cyclesPerNs;
+
+        ++accountHits[ParseFundAccount(order.fund_account) - FUND_ACCOUNT_BASE];
+        ++symbolHits[order.stock_code];
+        buyCount += order.entrust_bs == '1';
+        amountSum += order.entrust_amount;
+    }
+
+    // 最热的1%账户和最热的证券占全部订单的比例
+    std::sort(accountHits.begin(), accountHits.end(), std::greater<int64_t>());
+    auto hotAccounts = std::max<int64_t>(accountCount / 100, 1);
+    int64_t hotOrders = 0;
+    for (int64_t a = 0; a < hotAccounts; a++) {
+        hotOrders += accountHits[a];
+    }
+    auto activeAccounts = accountCount - std::count(accountHits.begin(), accountHits.end(), 0);
+    int64_t topSymbol = 0;
+    for (auto& hit : symbolHits) {
+        topSymbol = std::max(topSymbol, hit.second);
+    }
+
+    std::cout << fmt::format("workload: 订单{}笔, 生成{:.1f}ns/笔, 账户{}个(有订单{}个), 最热1%账户占{:.1f}%, 最热账户占{:.2f}%, "
+                             "证券{}只(有订单{}只), 最热证券占{:.1f}%, 买入{:.1f}%, 平均{:.0f}股",
+                             count, genNs / count, accountCount, activeAccounts, 100.0 * hotOrders / count, 100.0 * accountHits[0] / count,
+                             generator.GetSymbols().size(), symbolHits.size(), 100.0 * topSymbol / count, 100.0 * buyCount / count,
+                             (double)amountSum / count)
+              << std::endl;
+    return 0;
+}
+
+int RunBenchmark(const BenchOptions& options) {
+    if (options.count <= 0) {
+        std::cout << "测试次数必须大于0" << std::endl;
+        return -1;
+    }
+
+    if (options.name == "codec") {
+        return BenchCodec(options.count);
+    } else if (options.name == "layout") {
+        return BenchLayout(options.count);
+    } else if (options.name == "ledger") {
+        return BenchLedger(options.count);
+    } else if (options.name == "freeze") {
+        return BenchFreeze(options.count, options.threads, options.accountCount, options.workload.get());
+    } else if (options.name == "match") {
+        return BenchMatch(options.count, options.workload.get());
+    } else if (options.name == "workload") {
+        return BenchWorkload(options.count, options.accountCount, options.workload.get());
+    } else if (options.name == "pool") {
+        return BenchPool(options.count, options.threads);
+    }
+
+    std::cout << "不支持的测试: " << options.name << "，可选: codec layout ledger freeze match pool workload" << std::endl;
+    return -1;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file fund_ledger.cpp
+ * @brief 基于内存映射文件的资金账本
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "fund_ledger.h"
+
+#include <thread>
+
+#include "utils/exception_utils.h"
+#include "utils/os_utils.h"
+
+static constexpr uint64_t LEDGER_MAGIC = 0x5245474445444E46ULL;  // "FNDLEDGR"
+static constexpr uint32_t LEDGER_VERSION = 1;
+static constexpr uint32_t INDEX_RESERVED = UINT32_MAX;  // 索引项已被抢占，槽位尚未发布
+static constexpr uint32_t INDEX_DEAD = UINT32_MAX - 1;  // 异常退出时未发布的索引项，重新打开时作废，查找时跳过
+
+struct alignas(64) FundLedger::Header {
+    uint64_t magic;                   // 文件标识，新建文件为0
+    uint32_t version;                 // 文件版本
+    uint32_t slotSize;                // 槽位大小
+    uint32_t capacity;                // 最大账户数
+    uint32_t indexSize;               // 索引长度
+    std::atomic<uint32_t> count;      // 已分配的序号数
+    std::atomic<uint32_t> reserving;  // 正在占位的索引项数，打开时不为0说明上次进程在占位期间退出
+};
+
+FundLedger::FundLedger(const std::string& path, uint32_t capacity, bool preload)
+    : _path(path), _capacity(capacity), _preload(preload) {
+    if (capacity == 0 || capacity > (1U << 30)) {
+        throw library::utils::Exception("invalid fund ledger capacity " + std::to_string(capacity));
+    }
+
+    // 索引长度至少为容量的2倍，保证装载率不超过50%
+    uint32_t indexSize = 1;
+    while (indexSize < capacity * 2) {
+        indexSize <<= 1;
+    }
+    _indexMask = indexSize - 1;
+
+    _mapSize = sizeof(Header) + sizeof(FundSlot) * (size_t)capacity + sizeof(uint32_t) * (size_t)indexSize;
+    _address = library::utils::os::LoadMmapBuffer(path, _mapSize, !preload);
+    _header = reinterpret_cast<Header*>(_address);
+    _slots = reinterpret_cast<FundSlot*>(_address + sizeof(Header));
+    _index = reinterpret_cast<std::atomic<uint32_t>*>(_address + sizeof(Header) + sizeof(FundSlot) * (size_t)capacity);
+
+    if (_header->magic == 0) {
+        _header->version = LEDGER_VERSION;
+        _header->slotSize = sizeof(FundSlot);
+        _header->capacity = capacity;
+        _header->indexSize = indexSize;
+        _header->count.store(0, std::memory_order_relaxed);
+        _header->reserving.store(0, std::memory_order_relaxed);
+        _header->magic = LEDGER_MAGIC;
+    } else if (_header->magic != LEDGER_MAGIC || _header->version != LEDGER_VERSION || _header->slotSize != sizeof(FundSlot) ||
+               _header->capacity != capacity || _header->indexSize != indexSize) {
+        library::utils::os::ReleaseMmapBuffer(_address, _mapSize, !_preload);
+        throw library::utils::Exception("fund ledger " + path + " does not match capacity " + std::to_string(capacity));
+    } else if (_header->reserving.load(std::memory_order_relaxed) != 0) {
+        // 只有异常退出后才需要扫描索引，正常打开不访问索引页面
+        for (uint32_t i = 0; i <= _indexMask; i++) {
+            if (_index[i].load(std::memory_order_relaxed) == INDEX_RESERVED) {
+                _index[i].store(INDEX_DEAD, std::memory_order_relaxed);
+            }
+        }
+        _header->reserving.store(0, std::memory_order_relaxed);
+    }
+}
+
+FundLedger::~FundLedger() {
+    library::utils::os::ReleaseMmapBuffer(_address, _mapSize, !_preload);
+}
+
+uint32_t FundLedger::Hash(int64_t account) const {
+    return (uint32_t)(((uint64_t)account * 0x9E3779B97F4A7C15ULL) >> 32) & _indexMask;
+}
+
+uint32_t FundLedger::LoadIndex(uint32_t i) const {
+    auto value = _index[i].load(std::memory_order_acquire);
+    while (value == INDEX_RESERVED) {
+        std::this_thread::yield();
+        value = _index[i].load(std::memory_order_acquire);
+    }
+    return value;
+}
+
+int32_t FundLedger::Find(int64_t account) const {
+    if (account <= 0) {
+        return -1;
+    }
+
+    for (uint32_t i = Hash(account), n = 0; n <= _indexMask; i = (i + 1) & _indexMask, n++) {
+        auto value = LoadIndex(i);
+        if (value == 0) {
+            return -1;
+        }
+        if (value != INDEX_DEAD && _slots[value - 1].account == account) {
+            return (int32_t)(value - 1);
+        }
+    }
+    return -1;
+}
+
+int32_t FundLedger::FindOrAdd(int64_t account) {
+    if (account <= 0) {
+        return -1;
+    }
+
+    for (uint32_t i = Hash(account), n = 0; n <= _indexMask; i = (i + 1) & _indexMask, n++) {
+        auto value = LoadIndex(i);
+        while (value == 0) {
+            // 账本已满时不抢占索引项，空索引项保持为0，未命中的查找仍在此处结束
+            if (_header->count.load(std::memory_order_relaxed) >= _capacity) {
+                return -1;
+            }
+
+            // 先抢占索引项，抢到后再分配槽位，同一账户只有一个线程能走到分配
+            _header->reserving.fetch_add(1, std::memory_order_relaxed);
+            if (_index[i].compare_exchange_strong(value, INDEX_RESERVED, std::memory_order_acq_rel)) {
+                auto count = _header->count.load(std::memory_order_relaxed);
+                do {
+                    if (count >= _capacity) {
+                        // 检查后被其他线程占满，归还索引项
+                        _index[i].store(0, std::memory_order_release);
+                        _header->reserving.fetch_sub(1, std::memory_order_relaxed);
+                        return -1;
+                    }
+                } while (!_header->count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed));
+                _slots[count].account = account;
+
+                // 写完槽位再发布序号
+                _index[i].store(count + 1, std::memory_order_release);
+                _header->reserving.fetch_sub(1, std::memory_order_relaxed);
+                return (int32_t)count;
+            }
+            _header->reserving.fetch_sub(1, std::memory_order_relaxed);
+
+            // 被其他线程抢先，等它发布后再比较，对方因账本已满归还时重新抢占
+            value = LoadIndex(i);
+        }
+
+        if (value != INDEX_DEAD && _slots[value - 1].account == account) {
+            return (int32_t)(value - 1);
+        }
+    }
+    return -1;
+}
+
+uint32_t FundLedger::Size() const {
+    auto count = _header->count.load(std::memory_order_relaxed);
+    return count < _capacity ? count : _capacity;
+}
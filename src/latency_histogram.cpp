@@ -0,0 +1,120 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief HDR风格的对数分桶延迟直方图
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+int LatencyHistogram::BucketIndex(int64_t value) {
+    if (value < 2 * SUB_BUCKET_COUNT) {
+        return (int)value;
+    }
+    // 最高位为第e位时右移e-SUB_BUCKET_BITS位，得到[SUB_BUCKET_COUNT, 2*SUB_BUCKET_COUNT)内的子桶
+    int shift = 63 - __builtin_clzll((uint64_t)value) - SUB_BUCKET_BITS;
+    return shift * SUB_BUCKET_COUNT + (int)(value >> shift);
+}
+
+int64_t LatencyHistogram::BucketUpper(int index) {
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int shift = index / SUB_BUCKET_COUNT - 1;
+    int64_t sub = index - shift * SUB_BUCKET_COUNT;
+    return (int64_t)(((uint64_t)(sub + 1) << shift) - 1);
+}
+
+void LatencyHistogram::Record(int64_t value) {
+    value = std::max<int64_t>(value, 0);
+    ++_counts[BucketIndex(value)];
+    ++_count;
+    _sum += value;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+}
+
+void LatencyHistogram::Reset() {
+    memset(_counts, 0, sizeof(_counts));
+    _count = 0;
+    _min = INT64_MAX;
+    _max = 0;
+    _sum = 0;
+}
+
+int64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    // 第rank个值（从1开始）所在的桶
+    auto rank = std::max<int64_t>((int64_t)std::ceil(std::min(std::max(percentile, 0.0), 100.0) / 100 * _count), 1);
+    int64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += _counts[i];
+        if (seen >= rank) {
+            return std::min(BucketUpper(i), _max);
+        }
+    }
+    return _max;
+}
+
+bool LatencyHistogram::WritePercentiles(const std::string& path, double unitScale) const {
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    static constexpr int TICKS_PER_HALF_DISTANCE = 5;
+    fprintf(file, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    if (_count > 0) {
+        // 最后一个刻度的1/(1-百分位)超过总数后，后续刻度都落在最大值上，直接输出100%
+        for (double percentile = 0; percentile < 100;) {
+            auto value = ValueAtPercentile(percentile);
+            auto rank = std::max<int64_t>((int64_t)std::ceil(percentile / 100 * _count), 1);
+            if (value >= _max || rank >= _count) {
+                break;
+            }
+            fprintf(file, "%12.3f %2.12f %10lld %14.2f\n", value / unitScale, percentile / 100, (long long)rank, 100 / (100 - percentile));
+
+            auto halfDistance = std::pow(2.0, std::floor(std::log2(100 / (100 - percentile))) + 1);
+            percentile += 100 / (halfDistance * TICKS_PER_HALF_DISTANCE);
+        }
+        fprintf(file, "%12.3f %2.12f %10lld\n", _max / unitScale, 1.0, (long long)_count);
+    }
+
+    double variance = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (_counts[i] > 0) {
+            auto diff = std::min(BucketUpper(i), _max) - GetMean();
+            variance += diff * diff * _counts[i];
+        }
+    }
+    fprintf(file, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", GetMean() / unitScale,
+            _count > 0 ? std::sqrt(variance / _count) / unitScale : 0.0);
+    fprintf(file, "#[Max     = %12.3f, Total count    = %12lld]\n", _max / unitScale, (long long)_count);
+    fprintf(file, "#[Buckets = %12d, SubBuckets     = %12d]\n", BUCKET_COUNT / SUB_BUCKET_COUNT, SUB_BUCKET_COUNT);
+    return fclose(file) == 0;
+}
@@ -1,18 +1,205 @@
 /**
  * @file main.cpp
- * @brief redis队列测试，一个线程向list中rpush数据，一个线程从list中lpop数据
+ * @brief redis队列测试，生产线程按队列分片向list中rpush数据，消费者阻塞监听全部队列批量lpop数据
  */
+#include <algorithm>
+#include <atomic>
+#include <csignal>
 #include <iostream>
+#include <memory>
 #include <thread>
 
+#include "benchmark.h"
 #include "common_def.h"
 #include "fmt/format.h"
-#include "redispp/redispp.h"
+#include "freeze_engine.h"
+#include "fund_ledger.h"
+#include "matching_engine.h"
+#include "order_consumer.h"
+#include "order_producer.h"
+#include "order_sink.h"
+#include "order_workload.h"
+#include "queue_monitor.h"
+#include "redis_stand_in.h"
+#include "redispp/redis_shards.h"
 #include "utils/cmdline.h"
 #include "utils/time_utils.h"
 #include "xmf/xmf_json.h"
 
+static OrderConsumer* g_consumer = nullptr;  // 当前运行的消费者，用于信号处理
+static QueueMonitor* g_monitor = nullptr;    // 当前运行的队列监控，用于信号处理
+static std::atomic<bool> g_stopServe{false};  // 是否停止独立运行的Redis替身服务
+
+static void OnSignal(int) {
+    if (g_consumer) {
+        g_consumer->Stop();
+    }
+    if (g_monitor) {
+        g_monitor->Stop();
+    }
+    g_stopServe.store(true);
+}
+
+/**
+ * @brief 读取哨兵配置数组
+ * @param sentinelsPtr 哨兵配置数组，每个元素包含host和port
+ * @return library::redis::SentinelConfigArray 哨兵配置
+ */
+static library::redis::SentinelConfigArray ReadSentinels(const library::xmf::XmfValuePtr& sentinelsPtr) {
+    library::redis::SentinelConfigArray sentConfArr;
+    for (auto itor = sentinelsPtr->GetChildIterator(); !itor->IsEof(); itor->MoveNext()) {
+        auto sentinel = std::make_shared<library::redis::SentinelConfig>();
+        sentinel->host = itor->GetValue()->Item("host")->ToString();
+        sentinel->port = itor->GetValue()->Item("port")->ToInt();
+        sentConfArr.push_back(sentinel);
+    }
+    return sentConfArr;
+}
+
+/**
+ * @brief 查找可选的配置项
+ * @param objectPtr 配置对象
+ * @param key 配置项名称
+ * @return library::xmf::XmfValuePtr 配置项，不存在时为空
+ */
+static library::xmf::XmfValuePtr FindItem(const library::xmf::XmfValuePtr& objectPtr, const char* key) {
+    auto object = std::dynamic_pointer_cast<library::xmf::XmfObject>(objectPtr);
+    return object ? object->Find(key) : nullptr;
+}
+
+/**
+ * @brief 为每个分片启动一个Redis替身服务，失败时抛出library::utils::Exception
+ * @param shardConfigs 分片配置，进程内模式下哨兵地址改为替身服务的地址
+ * @param serve true-在分片配置的哨兵端口上监听（地址取第一个哨兵的host） false-由系统分配端口，供本进程连接
+ * @param latencyUs 替身服务每次读到请求后延迟回复的微秒数
+ * @param standIns 输出启动的替身服务
+ */
+static void StartStandIns(library::redis::ShardConfigArray& shardConfigs, bool serve, int64_t latencyUs,
+                          std::vector<std::unique_ptr<RedisStandIn>>& standIns) {
+    for (auto& shard : shardConfigs) {
+        StandInOptions options;
+        options.latencyUs = latencyUs;
+        if (serve && !shard.sentinelConfigs.empty()) {
+            options.host = shard.sentinelConfigs.front()->host;
+            options.sentinelPorts.clear();
+            for (auto& sentinel : shard.sentinelConfigs) {
+                auto& ports = options.sentinelPorts;
+                if (std::find(ports.begin(), ports.end(), sentinel->port) == ports.end()) {
+                    ports.push_back(sentinel->port);
+                }
+            }
+        }
+        standIns.emplace_back(new RedisStandIn(options));
+        standIns.back()->Start();
+
+        if (!serve) {
+            auto sentinel = std::make_shared<library::redis::SentinelConfig>();
+            sentinel->host = options.host;
+            sentinel->port = standIns.back()->GetSentinelPorts().front();
+            shard.sentinelConfigs = {sentinel};
+        }
+    }
+}
+
+// 每个工作线程的冻结统计，独占缓存行
+struct alignas(64) FreezeCounter {
+    int64_t frozen = 0;    // 冻结成功
+    int64_t rejected = 0;  // 账户不存在或资金不足
+};
+
 int main(int argc, char** argv) {
+    // 命令行处理
+    cmdline::parser parser;
+    parser.add<std::string>("type", 't', "订单角色: push-新增count个订单 pop-取出全部订单（-C持续消费） stat-从从库查询队列积压（-C每秒刷新） bench-本地性能测试 serve-在配置的哨兵端口上运行Redis替身服务直到Ctrl+C", false, "push", cmdline::oneof<std::string>("push", "pop", "stat", "bench", "serve"));
+    parser.add<int64_t>("account_count", 'a', "账户数量，push及pop初始化资金时有效", false, 1);         // 默认1个账户
+    parser.add<int64_t>("orde_count", 'n', "订单数量，push时有效", false, 10000);        // 默认1万笔订单
+    parser.add<int64_t>("queue_count", 'c', "队列数量，push时有效", false, 1);           // 默认1个队列
+    parser.add<std::string>("queue_name", 'q', "订单队列的名称", false, "order_queue");  // 订单队列名称 queue_name_i
+    parser.add<int64_t>("batch", 'b', "每批推送的订单数量，push时有效，0-逐笔推送", false, 0);  // 批量模式下每批一次网络往返
+    parser.add<int64_t>("async_window", 'W', "每个生产线程在途的异步RPUSH数量上限，push时有效，0-同步推送", false, 0);  // 大于0时忽略batch
+    parser.add<int64_t>("auto_pipeline", 'P', "自动合并各生产线程并发的逐笔RPUSH，每批最多的命令数，push时有效，0-不合并", false, 0);
+    parser.add<int64_t>("linger_us", 'U', "自动合并时等待凑批的最长时间（微秒），指定auto_pipeline时有效", false, 0);
+    parser.add("script", 'S', "通过lua脚本在redis中原子地分配订单编号、推送订单并累加账户订单数，逐笔或每批一次往返，push时有效，不支持stream及async_window");
+    parser.add<int64_t>("id_block", 'i', "订单编号每次预留的号段大小，push时有效", false, 1000);
+    parser.add<double>("rate", 'r', "开环推送的总速率（笔/秒），按计划时间放行订单，延迟从计划时间起算，push时有效，0-尽快推送", false, 0);
+    parser.add<int64_t>("burst", 'j', "限速时每次同时放行的订单数，指定rate时有效", false, 1);
+    parser.add<double>("ramp_s", 'p', "限速时速率从0线性增加到rate所用的秒数，指定rate时有效", false, 0);
+    parser.add<int64_t>("threads", 'T', "生产线程数，按队列分片，push时有效", false, 1);  // 线程数不超过队列数
+    parser.add<std::string>("backend", 'x', "订单队列: list-List（RPUSH/LPOP） stream-Stream（XADD/XREADGROUP/XACK）", false, "list", cmdline::oneof<std::string>("list", "stream"));
+    parser.add<std::string>("group", 'g', "Stream消费组名称，backend为stream时pop及stat有效", false, "order_group");
+    parser.add<std::string>("consumer", 'u', "Stream消费者名称，各消费进程必须不同，为空时使用主机名_进程号，backend为stream时pop有效", false, "");
+    parser.add<int64_t>("claim_ms", 'm', "认领其他消费者超过该时长（毫秒）未确认的订单，backend为stream时pop有效", false, 30000);
+    parser.add<int64_t>("pop_batch", 'k', "每次LPOP（Stream为每个队列XREADGROUP COUNT）最多弹出的订单数量，pop时有效", false, 100);
+    parser.add<int64_t>("workers", 'w', "消费工作线程数，同一队列由同一线程按序处理，pop时有效", false, 1);
+    parser.add("continuous", 'C', "持续消费，阻塞等待新订单直到Ctrl+C，pop时有效；stat时每秒刷新直到Ctrl+C");
+    parser.add<std::string>("sink", 's', "消费订单的输出: null-丢弃 csv-CSV文件 binary-Order二进制文件，pop时有效", false, "csv", cmdline::oneof<std::string>("null", "csv", "binary"));
+    parser.add<std::string>("sink_path", 'o', "输出文件前缀，每个工作线程写入sink_path_i.csv/.bin，pop时有效", false, "consumed_orders");
+    parser.add<std::string>("codec", 'e', "订单编码: compact-紧凑编码 raw-原始结构，push时有效", false, "compact", cmdline::oneof<std::string>("compact", "raw"));
+    parser.add<std::string>("ledger", 'L', "资金账本文件，pop时对买入委托冻结资金，为空时不冻结", false, "");
+    parser.add<std::string>("init_fund", 'F', "消费前将account_count个测试账户的可用资金重置为该值，0-不重置，指定ledger时有效", false, "0");
+    parser.add("match", 'M', "消费时按证券撮合并回填成交字段，pop时有效");
+    parser.add<std::string>("bench", 'B', "本地性能测试名称: codec layout ledger freeze match pool workload，bench时有效，次数由orde_count指定，freeze使用threads和account_count，pool使用threads，freeze match workload使用workload", false, "codec");
+    parser.add<std::string>("workload", 'f', "订单分布配置文件（JSON），指定账户的Zipf分布、证券池及价格范围、买卖比例和数量分布，push及bench时有效，为空时使用固定的测试订单", false, "");
+    parser.add<std::string>("latency_file", 'H', "端到端延迟的百分位分布文件（HdrHistogram .hgrm格式，微秒），pop时有效，为空时只输出摘要", false, "");
+    parser.add("stand_in", 'R', "不连接真实redis，在进程内为每个分片启动一个Redis替身服务并连接它，用于隔离测量客户端吞吐，不支持script");
+    parser.add<int64_t>("stand_in_latency_us", 'D', "Redis替身服务每次读到请求后延迟回复的微秒数，模拟网络往返，stand_in或serve时有效", false, 0);
+    parser.parse_check(argc, argv);
+
+    auto type = parser.get<std::string>("type");
+    auto accountCount = parser.get<int64_t>("account_count");
+    auto orderCount = parser.get<int64_t>("orde_count");
+    auto queueCount = parser.get<int64_t>("queue_count");
+    auto queueName = parser.get<std::string>("queue_name");
+    auto batch = parser.get<int64_t>("batch");
+    auto asyncWindow = parser.get<int64_t>("async_window");
+    auto autoPipeline = parser.get<int64_t>("auto_pipeline");
+    auto lingerUs = parser.get<int64_t>("linger_us");
+    auto script = parser.exist("script");
+    auto idBlock = parser.get<int64_t>("id_block");
+    auto threads = parser.get<int64_t>("threads");
+    PaceOptions pace;
+    pace.rate = parser.get<double>("rate");
+    pace.burst = parser.get<int64_t>("burst");
+    pace.rampSeconds = parser.get<double>("ramp_s");
+    auto stream = parser.get<std::string>("backend") == "stream";
+    auto group = parser.get<std::string>("group");
+    auto consumerName = parser.get<std::string>("consumer");
+    auto claimMs = parser.get<int64_t>("claim_ms");
+    auto popBatch = parser.get<int64_t>("pop_batch");
+    auto workers = parser.get<int64_t>("workers");
+    auto continuous = parser.exist("continuous");
+    auto sinkType = parser.get<std::string>("sink");
+    auto sinkPath = parser.get<std::string>("sink_path");
+    auto codec = parser.get<std::string>("codec");
+    auto ledgerPath = parser.get<std::string>("ledger");
+    auto initFundStr = parser.get<std::string>("init_fund");
+    auto match = parser.exist("match");
+    auto latencyFile = parser.get<std::string>("latency_file");
+    auto standIn = parser.exist("stand_in");
+    auto standInLatencyUs = parser.get<int64_t>("stand_in_latency_us");
+
+    auto workloadPath = parser.get<std::string>("workload");
+    std::shared_ptr<WorkloadProfile> workload;
+    if (!workloadPath.empty()) {
+        try {
+            workload = std::make_shared<WorkloadProfile>(OrderWorkload::LoadProfile(workloadPath));
+        } catch (library::utils::Exception& e) {
+            std::cout << "读取订单分布配置失败:" << e.what() << std::endl;
+            return -1;
+        }
+    }
+
+    // 本地性能测试不需要连接redis
+    if (type == "bench") {
+        BenchOptions options;
+        options.name = parser.get<std::string>("bench");
+        options.count = orderCount;
+        options.threads = threads;
+        options.accountCount = accountCount;
+        options.workload = workload;
+        return RunBenchmark(options);
+    }
+
     library::xmf::XmfJson xmfJson;
     auto dataPtr = xmfJson.Read("config.json");
     if (!dataPtr) {
@@ -20,6 +207,7 @@ int main(int argc, char** argv) {
         return false;
     }
 
+    std::vector<std::unique_ptr<RedisStandIn>> standIns;  // Redis替身服务，存活到进程退出
     try {
         // Redis配置
         auto redisCfgPtr = dataPtr->Item("redis");
@@ -34,14 +222,7 @@ int main(int argc, char** argv) {
             return -1;
         }
 
-        library::redis::SentinelConfigArray sentConfArr;  // redis哨兵配置
-
-        for (auto itor = sentinelsPtr->GetChildIterator(); !itor->IsEof(); itor->MoveNext()) {
-            auto sentinel = std::make_shared<library::redis::SentinelConfig>();
-            sentinel->host = itor->GetValue()->Item("host")->ToString();
-            sentinel->port = itor->GetValue()->Item("port")->ToInt();
-            sentConfArr.push_back(sentinel);
-        }
+        auto sentConfArr = ReadSentinels(sentinelsPtr);  // redis哨兵配置
 
         // redis配置
         auto redisConfPtr = std::make_shared<library::redis::RedisConfig>();
@@ -53,98 +234,233 @@ int main(int argc, char** argv) {
         redisConfPtr->connectTimeout = redisCfgPtr->Item("connect_timeout")->ToInt();
         redisConfPtr->socketTimeout = redisCfgPtr->Item("socket_timeout")->ToInt();
         redisConfPtr->poolSize = redisCfgPtr->Item("pool_size")->ToInt();
+        redisConfPtr->autoPipeline = autoPipeline > 0;
+        redisConfPtr->pipelineMaxBatch = (int)autoPipeline;
+        redisConfPtr->pipelineLingerUs = (int)lingerUs;
+
+        // 分片配置，redis->shards中每个分片覆盖master_name，可选覆盖sentinels和name（决定哈希位置，默认为master_name），
+        // 其余配置与redis相同；没有shards时只有一个分片
+        library::redis::ShardConfigArray shardConfigs;
+        auto shardsPtr = FindItem(redisCfgPtr, "shards");
+        if (shardsPtr == nullptr) {
+            shardConfigs.push_back({"", sentConfArr, redisConfPtr});
+        } else {
+            for (auto itor = shardsPtr->GetChildIterator(); !itor->IsEof(); itor->MoveNext()) {
+                auto shardPtr = itor->GetValue();
+                library::redis::ShardConfig shard;
+                shard.redisConfig = std::make_shared<library::redis::RedisConfig>(*redisConfPtr);
+                shard.redisConfig->masterName = shardPtr->Item("master_name")->ToString();
+                auto namePtr = FindItem(shardPtr, "name");
+                shard.name = namePtr ? namePtr->ToString() : "";
+                auto shardSentinelsPtr = FindItem(shardPtr, "sentinels");
+                shard.sentinelConfigs = shardSentinelsPtr ? ReadSentinels(shardSentinelsPtr) : sentConfArr;
+                shardConfigs.push_back(shard);
+            }
+        }
 
-        // 初始化Reids配置
-        library::redis::Redispp::Instance()->Init(sentConfArr, redisConfPtr);
+        if (type == "serve" || standIn) {
+            try {
+                StartStandIns(shardConfigs, type == "serve", standInLatencyUs, standIns);
+            } catch (library::utils::Exception& e) {
+                std::cout << "启动Redis替身服务失败: " << e.what() << std::endl;
+                return -1;
+            }
+        }
+
+        // 独立运行替身服务，供其他进程按config.json连接
+        if (type == "serve") {
+            std::vector<std::string> names;
+            for (size_t i = 0; i < standIns.size(); i++) {
+                auto& server = *standIns[i];
+                auto& shard = shardConfigs[i];
+                names.push_back("分片[" + (shard.name.empty() ? shard.redisConfig->masterName : shard.name) + "]");
+                std::string sentinels;
+                for (auto port : server.GetSentinelPorts()) {
+                    sentinels += (sentinels.empty() ? "" : ",") + std::to_string(port);
+                }
+                std::cout << names[i] << "Redis替身服务 哨兵:" << server.GetHost() << ":" << sentinels << " 主库:" << server.GetMasterPort()
+                          << " 从库:" << server.GetReplicaPort() << std::endl;
+            }
+            signal(SIGINT, OnSignal);
+            signal(SIGTERM, OnSignal);
+            while (!g_stopServe.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            for (size_t i = 0; i < standIns.size(); i++) {
+                standIns[i]->Stop();
+                std::cout << names[i] << "Redis替身服务处理命令数:" << standIns[i]->GetCommandCount() << std::endl;
+            }
+            return 0;
+        }
+
+        // 初始化Reids配置，第一个分片即Redispp::Instance()
+        library::redis::RedisShards::Instance()->Init(shardConfigs);
     } catch (library::utils::Exception& e) {
         std::cout << "读取config.json失败: " << e.what() << std::endl;
         return false;
     }
 
-    // 命令行处理
-    cmdline::parser parser;
-    parser.add<std::string>("type", 't', "订单角色: push-新增count个订单 pop-取出全部订单", false, "push", cmdline::oneof<std::string>("push", "pop"));
-    parser.add<int64_t>("account_count", 'a', "账户数量，push时有效", false, 1);         // 默认1个账户
-    parser.add<int64_t>("orde_count", 'n', "订单数量，push时有效", false, 10000);        // 默认1万笔订单
-    parser.add<int64_t>("queue_count", 'c', "队列数量，push时有效", false, 1);           // 默认1个队列
-    parser.add<std::string>("queue_name", 'q', "订单队列的名称", false, "order_queue");  // 订单队列名称 queue_name_i
-    parser.parse_check(argc, argv);
-
-    auto type = parser.get<std::string>("type");
-    auto accountCount = parser.get<int64_t>("account_count");
-    auto orderCount = parser.get<int64_t>("orde_count");
-    auto queueCount = parser.get<int64_t>("queue_count");
-    auto queueName = parser.get<std::string>("queue_name");
-
     int64_t clOrderId = library::utils::Time::NowNano();
 
     // 向队列中添加订单
     if (type == "push") {
-        library::redis::RedisProxy redis;
-        if (redis == nullptr) {
-            std::cout << "Redis连接数不够" << std::endl;
+        if (script && (stream || asyncWindow > 0)) {
+            std::cout << "script只支持List同步推送，不能与stream或async_window同时使用" << std::endl;
+            return -1;
+        }
+        if (script && standIn) {
+            std::cout << "Redis替身服务不支持lua脚本，script不能与stand_in同时使用" << std::endl;
+            return -1;
+        }
+        if (script && library::redis::RedisShards::Instance()->GetShardCount() > 1) {
+            std::cout << "script在各分片上的订单编号计数器相互独立，不支持多个redis分片" << std::endl;
             return -1;
         }
 
-        int64_t clientId = 600000000001;
-        int64_t fundAccount = 700000000001;
+        ProducerOptions options;
+        options.accountCount = accountCount;
+        options.orderCount = orderCount;
+        options.queueCount = queueCount;
+        options.queueName = queueName;
+        options.batch = batch;
+        options.idBlock = idBlock;
+        options.threads = threads;
+        options.compact = codec == "compact";
+        options.asyncWindow = asyncWindow;
+        options.stream = stream;
+        options.script = script;
+        options.pace = pace;
+        if (workload) {
+            options.workload = *workload;
+        }
 
-        Order order;
-        order.branch_no = 30;
-        strcpy(order.password, "abc123");
-        order.batch_no = 0;
-        strcpy(order.stock_account, "B880820006");
-        order.exchange_type = '1';  // 1-上海
-        strcpy(order.stock_code, "600028");
-        order.op_entrust_way = '1';  // 限价委托
-        order.entrust_prop = '0';
-        order.entrust_bs = '1';
-        order.entrust_amount = 300;
-        order.entrust_price = 4.26;
-        order.registe_sure_flag = '1';
+        OrderProducer producer(options);
+        if (!producer.Run()) {
+            return -1;
+        }
+    } else if (type == "stat") {
+        MonitorOptions options;
+        options.queueCount = queueCount;
+        options.queueName = queueName;
+        options.stream = stream;
+        options.group = group;
+        options.continuous = continuous;
 
-        try {
-            for (size_t i = 0; i < orderCount; i++) {
-                strcpy(order.client_id, std::to_string(clientId + i % accountCount).c_str());
-                strcpy(order.fund_account, std::to_string(fundAccount + i % accountCount).c_str());
-                strcpy(order.order_id, std::to_string(redis->incr("order_no")).c_str());
-                redis->rpush(fmt::format("{}_{}", queueName, (fundAccount + i % accountCount) % queueCount), sw::redis::StringView((const char*)&order, sizeof(order)));
+        QueueMonitor monitor(options);
+        g_monitor = &monitor;
+        signal(SIGINT, OnSignal);
+        signal(SIGTERM, OnSignal);
+        bool ok = monitor.Run();
+        g_monitor = nullptr;
+        if (!ok) {
+            return -1;
+        }
+    } else {
+        ConsumerOptions options;
+        options.queueCount = queueCount;
+        options.queueName = queueName;
+        options.popBatch = popBatch;
+        options.workers = workers;
+        options.continuous = continuous;
+        options.stream = stream;
+        options.group = group;
+        options.consumerName = consumerName;
+        options.claimIdleMs = claimMs;
+        options.latencyPath = latencyFile;
+
+        // 资金冻结
+        std::unique_ptr<FundLedger> ledger;
+        std::unique_ptr<FreezeEngine> freezer;
+        std::vector<FreezeCounter> counters(std::max<int64_t>(workers, 1));
+        OrderHandler handler;
+        if (!ledgerPath.empty()) {
+            Money initFund;
+            if (!Money::Parse(initFundStr, initFund) || initFund < Money()) {
+                std::cout << "init_fund格式错误: " << initFundStr << std::endl;
+                return -1;
+            }
+
+            try {
+                ledger.reset(new FundLedger(ledgerPath));
+            } catch (library::utils::Exception& e) {
+                std::cout << "打开资金账本失败: " << e.what() << std::endl;
+                return -1;
             }
+            freezer.reset(new FreezeEngine(*ledger));
 
-            std::cout << "批量创建" << orderCount << "笔订单成功" << std::endl;
-        } catch (const sw::redis::Error& e) {
-            // 出现异常，丢弃该连接
-            redis.SetInvalid();
-            std::cout << "Redis操作异常:" << e.what() << std::endl;
+            if (initFund > Money()) {
+                for (int64_t i = 0; i < accountCount; i++) {
+                    auto id = ledger->FindOrAdd(FUND_ACCOUNT_BASE + i);
+                    if (id < 0) {
+                        std::cout << "资金账本已满" << std::endl;
+                        return -1;
+                    }
+                    freezer->Reset(id, initFund);
+                }
+            }
         }
-    } else {
-        library::redis::RedisProxy redis;
-        if (redis == nullptr) {
-            std::cout << "Redis连接数不够" << std::endl;
-            return -1;
+
+        // 撮合，资金不足的委托为废单，不参与撮合
+        std::unique_ptr<MatchingEngine> matcher;
+        if (match) {
+            matcher.reset(new MatchingEngine());
         }
 
-        try {
-            int sum = 0;
-            for (size_t i = 0; i < queueCount; i++) {
-                auto element = redis->lpop(fmt::format("{}_{}", queueName, i));
-                while (element) {
-                    ++sum;
-                    auto order = (Order*)element->data();
-                    std::cout << "Order[编号:" << order->order_id << ",账户:" << order->fund_account
-                              << ",代码:" << order->exchange_type << "|" << order->stock_code
-                              << ",买卖:" << order->entrust_bs << ",价格:" << order->entrust_price << ",数量:" << order->entrust_amount << std::endl;
-                    element = redis->lpop(fmt::format("{}_{}", queueName, i));
+        if (freezer || matcher) {
+            handler = [&](int64_t worker, int64_t, Order& order) {
+                if (freezer) {
+                    auto& counter = counters[worker];
+                    if (!freezer->Freeze(order)) {
+                        counter.rejected++;
+                        order.entrust_status = ENTRUST_STATUS_INVALID;
+                        return;
+                    }
+                    counter.frozen++;
                 }
-            }
+                if (matcher) {
+                    matcher->Match(order);
+                }
+            };
+        }
+
+        auto sinkFactory = MakeSinkFactory(sinkType, sinkPath, 1 << 20);
+        OrderConsumer consumer(options, sinkFactory, handler);
 
-            std::cout << "批量消费" << sum << "笔订单成功" << std::endl;
-        } catch (const sw::redis::Error& e) {
-            // 出现异常，丢弃该连接
-            redis.SetInvalid();
-            std::cout << "Redis操作异常:" << e.what() << std::endl;
+        // 持续消费模式下通过Ctrl+C退出
+        g_consumer = &consumer;
+        signal(SIGINT, OnSignal);
+        signal(SIGTERM, OnSignal);
+
+        bool ok = false;
+        try {
+            ok = consumer.Run();
+        } catch (library::utils::Exception& e) {
+            std::cout << "消费失败: " << e.what() << std::endl;
+        }
+        g_consumer = nullptr;
+
+        if (freezer) {
+            FreezeCounter total;
+            for (auto& counter : counters) {
+                total.frozen += counter.frozen;
+                total.rejected += counter.rejected;
+            }
+            std::cout << "资金冻结成功" << total.frozen << "笔，拒绝" << total.rejected << "笔" << std::endl;
+        }
+        if (!ok) {
+            return -1;
         }
     }
 
+    auto& shards = *library::redis::RedisShards::Instance();
+    for (int i = 0; i < shards.GetShardCount(); i++) {
+        auto connections = shards.GetShard(i).GetConnectionStats();
+        std::cout << (shards.GetShardCount() > 1 ? "分片[" + shards.GetShardName(i) + "]" : "") << "redis连接对象数:" << connections.redisConnections
+                  << "（从库" << connections.replicaConnections << "），数据库实例数:" << connections.dbCount << std::endl;
+    }
+    for (size_t i = 0; i < standIns.size(); i++) {
+        std::cout << (standIns.size() > 1 ? "分片[" + shards.GetShardName((int)i) + "]" : "") << "Redis替身服务处理命令数:"
+                  << standIns[i]->GetCommandCount() << std::endl;
+    }
     return 0;
 }
@@ -0,0 +1,195 @@
+/**
+ * @file matching_engine.cpp
+ * @brief 进程内撮合模拟
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "matching_engine.h"
+
+#include <algorithm>
+#include <cstring>
+
+OrderBook::OrderBook(Price refPrice, int bandPercent) {
+    int64_t refTick = std::max<int64_t>(refPrice.Raw() / TICK_RAW, 1);
+    int64_t band = std::max<int64_t>(refTick * bandPercent / 100, 1);
+    _lowTick = std::max<int64_t>(refTick - band, 1);
+    _levelCount = (int32_t)(refTick + band - _lowTick + 1);
+    _bids.resize(_levelCount);
+    _asks.resize(_levelCount);
+    _bestAsk = _levelCount;
+}
+
+uint32_t OrderBook::AllocNode() {
+    if (_freeHead != NIL) {
+        auto idx = _freeHead;
+        _freeHead = _nodes[idx].next;
+        return idx;
+    }
+    _nodes.emplace_back();
+    return (uint32_t)_nodes.size() - 1;
+}
+
+void OrderBook::FreeNode(uint32_t idx) {
+    _nodes[idx].next = _freeHead;
+    _freeHead = idx;
+}
+
+template <bool BUY>
+int32_t OrderBook::Cross(int32_t tick, int32_t amount, int32_t entrustNo, Money& dealMoney, const FillHandler& onFill) {
+    auto& levels = BUY ? _asks : _bids;
+    auto& best = BUY ? _bestAsk : _bestBid;
+
+    // 买单与不高于委托价的卖档位撮合，卖单与不低于委托价的买档位撮合
+    while (amount > 0 && (BUY ? best <= tick : best >= tick)) {
+        auto& level = levels[best];
+        auto price = PriceOf(best);
+        while (amount > 0 && level.head != NIL) {
+            auto& node = _nodes[level.head];
+            auto fill = std::min(amount, node.amount);
+            node.amount -= fill;
+            level.amount -= fill;
+            amount -= fill;
+            dealMoney += price * fill;
+            if (onFill) {
+                onFill(Fill{entrustNo, node.entrustNo, price, fill});
+            }
+
+            if (node.amount == 0) {
+                auto idx = level.head;
+                level.head = node.next;
+                FreeNode(idx);
+            }
+        }
+
+        if (level.head == NIL) {
+            level.tail = NIL;
+            if (BUY) {
+                while (++best < _levelCount && _asks[best].head == NIL) {
+                }
+            } else {
+                while (--best >= 0 && _bids[best].head == NIL) {
+                }
+            }
+        }
+    }
+    return amount;
+}
+
+bool OrderBook::Match(Order& order, int32_t entrustNo, const FillHandler& onFill) {
+    order.entrust_no = entrustNo;
+    order.deal_amount = 0;
+    order.deal_price = Price();
+
+    bool buy = order.entrust_bs == '1';
+    int64_t tick = order.entrust_price.Raw() / TICK_RAW - _lowTick;
+    if ((!buy && order.entrust_bs != '2') || order.entrust_amount <= 0 || order.entrust_price.Raw() % TICK_RAW != 0 || tick < 0 ||
+        tick >= _levelCount) {
+        order.entrust_status = ENTRUST_STATUS_INVALID;
+        return false;
+    }
+
+    Money dealMoney;
+    auto left = buy ? Cross<true>((int32_t)tick, order.entrust_amount, entrustNo, dealMoney, onFill)
+                    : Cross<false>((int32_t)tick, order.entrust_amount, entrustNo, dealMoney, onFill);
+
+    // 剩余数量挂入本方档位末尾
+    if (left > 0) {
+        auto idx = AllocNode();
+        _nodes[idx] = Node{NIL, entrustNo, left};
+        auto& level = buy ? _bids[tick] : _asks[tick];
+        if (level.tail == NIL) {
+            level.head = idx;
+        } else {
+            _nodes[level.tail].next = idx;
+        }
+        level.tail = idx;
+        level.amount += left;
+
+        if (buy) {
+            _bestBid = std::max(_bestBid, (int32_t)tick);
+        } else {
+            _bestAsk = std::min(_bestAsk, (int32_t)tick);
+        }
+    }
+
+    auto dealAmount = order.entrust_amount - left;
+    if (dealAmount > 0) {
+        order.deal_amount = dealAmount;
+        order.deal_price = dealMoney / dealAmount;
+    }
+    order.entrust_status = left == 0 ? ENTRUST_STATUS_FILLED : (dealAmount > 0 ? ENTRUST_STATUS_PARTIAL : ENTRUST_STATUS_REPORTED);
+    return true;
+}
+
+Price OrderBook::BestBid() const {
+    return _bestBid >= 0 ? PriceOf(_bestBid) : Price();
+}
+
+Price OrderBook::BestAsk() const {
+    return _bestAsk < _levelCount ? PriceOf(_bestAsk) : Price();
+}
+
+int64_t OrderBook::LevelAmount(char bs, Price price) const {
+    int64_t tick = price.Raw() / TICK_RAW - _lowTick;
+    if (price.Raw() % TICK_RAW != 0 || tick < 0 || tick >= _levelCount) {
+        return 0;
+    }
+    return bs == '1' ? _bids[tick].amount : _asks[tick].amount;
+}
+
+MatchingEngine::MatchingEngine(FillHandler onFill)
+    : _onFill(onFill) {
+}
+
+MatchingEngine::Book* MatchingEngine::GetBook(const Order& order) {
+    // 证券代码一般不超过7位，键在短字符串优化范围内，查找不分配内存
+    std::string key(1, order.exchange_type);
+    key.append(order.stock_code, strnlen(order.stock_code, sizeof(order.stock_code)));
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto itor = _books.find(key);
+        if (itor != _books.end()) {
+            return itor->second.get();
+        }
+    }
+
+    // 参考价决定整个交易日的价格范围，非法价格建簿会使该证券后续委托全部成为废单
+    if (!OrderBook::IsValidRefPrice(order.entrust_price)) {
+        return nullptr;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    auto& book = _books[key];
+    if (!book) {
+        book.reset(new Book(order.entrust_price));
+    }
+    return book.get();
+}
+
+bool MatchingEngine::Match(Order& order) {
+    auto entrustNo = _entrustNo.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto book = GetBook(order);
+    if (!book) {
+        order.entrust_no = entrustNo;
+        order.deal_amount = 0;
+        order.deal_price = Price();
+        order.entrust_status = ENTRUST_STATUS_INVALID;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(book->mutex);
+    return book->book.Match(order, entrustNo, _onFill);
+}
+
+size_t MatchingEngine::BookCount() const {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _books.size();
+}
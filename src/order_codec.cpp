@@ -0,0 +1,262 @@
+/**
+ * @file order_codec.cpp
+ * @brief 订单紧凑编码
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "order_codec.h"
+
+#include <cstring>
+
+// 字段序号及字段名，序号即位图中的位置，发布后不可修改
+#define ORDER_CODEC_FIELDS(X) \
+    X(0, branch_no)           \
+    X(1, client_id)           \
+    X(2, fund_account)        \
+    X(3, password)            \
+    X(4, order_id)            \
+    X(5, batch_no)            \
+    X(6, stock_account)       \
+    X(7, exchange_type)       \
+    X(8, stock_code)          \
+    X(9, op_entrust_way)      \
+    X(10, entrust_prop)       \
+    X(11, entrust_bs)         \
+    X(12, entrust_amount)     \
+    X(13, entrust_price)      \
+    X(14, entrust_money)      \
+    X(15, registe_sure_flag)  \
+    X(16, init_date)          \
+    X(17, entrust_time)       \
+    X(18, entrust_no)         \
+    X(19, report_no)          \
+    X(20, seat_no)            \
+    X(21, deal_price)         \
+    X(22, deal_amount)        \
+    X(23, cancel_amount)      \
+    X(24, entrust_status)     \
+    X(25, fees)               \
+    X(26, freeze_money)       \
+    X(27, update_time)        \
+    X(28, remark)             \
+    X(29, send_time)
+
+static constexpr uint64_t KNOWN_FIELDS_MASK = (1ULL << 30) - 1;  // 当前版本的全部字段
+
+namespace {
+    // 顺序写入缓冲区，越界后不再写入
+    struct Writer {
+        char* p;
+        char* end;
+        bool ok = true;
+
+        void Byte(uint8_t v) {
+            if (p < end) {
+                *p++ = (char)v;
+            } else {
+                ok = false;
+            }
+        }
+
+        void Varint(uint64_t v) {
+            while (v >= 0x80) {
+                Byte((uint8_t)(v | 0x80));
+                v >>= 7;
+            }
+            Byte((uint8_t)v);
+        }
+
+        void Bytes(const void* data, size_t len) {
+            if (end - p >= (ptrdiff_t)len) {
+                memcpy(p, data, len);
+                p += len;
+            } else {
+                ok = false;
+            }
+        }
+    };
+
+    // 顺序读取编码数据，越界后ok为false
+    struct Reader {
+        const char* p;
+        const char* end;
+        uint8_t version = OrderCodec::VERSION;
+        bool ok = true;
+
+        uint8_t Byte() {
+            if (p < end) {
+                return (uint8_t)*p++;
+            }
+            ok = false;
+            return 0;
+        }
+
+        uint64_t Varint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t b = Byte();
+                v |= (uint64_t)(b & 0x7F) << shift;
+                if (!(b & 0x80)) {
+                    return v;
+                }
+            }
+            ok = false;
+            return 0;
+        }
+
+        const char* Bytes(size_t len) {
+            if (end - p >= (ptrdiff_t)len) {
+                auto data = p;
+                p += len;
+                return data;
+            }
+            ok = false;
+            return nullptr;
+        }
+    };
+
+    // 各类型字段是否有值
+    inline bool IsSet(int32_t v) { return v != 0; }
+    inline bool IsSet(int64_t v) { return v != 0; }
+    inline bool IsSet(char v) { return v != 0; }
+    inline bool IsSet(double v) { return v != 0; }
+    inline bool IsSet(Price v) { return v.Raw() != 0; }
+    template <size_t N>
+    inline bool IsSet(const char (&v)[N]) { return v[0] != 0; }
+
+    // 各类型字段的编码
+    inline void Put(Writer& w, int32_t v) { w.Varint((uint32_t)((uint32_t)v << 1) ^ (uint32_t)(v >> 31)); }
+    inline void Put(Writer& w, int64_t v) { w.Varint(((uint64_t)v << 1) ^ (uint64_t)(v >> 63)); }
+    inline void Put(Writer& w, char v) { w.Byte((uint8_t)v); }
+    inline void Put(Writer& w, double v) { w.Bytes(&v, sizeof(v)); }
+    inline void Put(Writer& w, Price v) { w.Varint(((uint64_t)v.Raw() << 1) ^ (uint64_t)(v.Raw() >> 63)); }
+    template <size_t N>
+    inline void Put(Writer& w, const char (&v)[N]) {
+        auto len = strnlen(v, N);
+        w.Varint(len);
+        w.Bytes(v, len);
+    }
+
+    // 各类型字段的解码
+    inline void Get(Reader& r, int32_t& v) {
+        auto u = (uint32_t)r.Varint();
+        v = (int32_t)((u >> 1) ^ (~(u & 1) + 1));
+    }
+    inline void Get(Reader& r, int64_t& v) {
+        auto u = r.Varint();
+        v = (int64_t)((u >> 1) ^ (~(u & 1) + 1));
+    }
+    inline void Get(Reader& r, char& v) { v = (char)r.Byte(); }
+    inline void Get(Reader& r, double& v) {
+        auto data = r.Bytes(sizeof(v));
+        if (data) {
+            memcpy(&v, data, sizeof(v));
+        }
+    }
+    inline void Get(Reader& r, Price& v) {
+        if (r.version == 1) {
+            double d = 0;
+            Get(r, d);
+            v = Price::FromDouble(d);
+            return;
+        }
+        auto u = r.Varint();
+        v = Price::FromRaw((int64_t)((u >> 1) ^ (~(u & 1) + 1)));
+    }
+    template <size_t N>
+    inline void Get(Reader& r, char (&v)[N]) {
+        auto len = r.Varint();
+        if (len > N) {
+            r.ok = false;
+            return;
+        }
+        auto data = r.Bytes(len);
+        if (data) {
+            memcpy(v, data, len);
+            if (len < N) {
+                v[len] = 0;
+            }
+        }
+    }
+}  // namespace
+
+size_t OrderCodec::Encode(const Order& order, char* buf, size_t size) {
+    uint64_t mask = 0;
+#define X(idx, name)          \
+    if (IsSet(order.name)) {  \
+        mask |= 1ULL << idx;  \
+    }
+    ORDER_CODEC_FIELDS(X)
+#undef X
+
+    Writer w{buf, buf + size};
+    w.Byte(MAGIC);
+    w.Byte(VERSION);
+    w.Varint(mask);
+#define X(idx, name)           \
+    if (mask & (1ULL << idx)) { \
+        Put(w, order.name);     \
+    }
+    ORDER_CODEC_FIELDS(X)
+#undef X
+
+    return w.ok ? w.p - buf : 0;
+}
+
+bool OrderCodec::Decode(const char* data, size_t size, Order& order) {
+    Reader r{data, data + size};
+    if (r.Byte() != MAGIC) {
+        return false;
+    }
+    r.version = r.Byte();
+    if (!r.ok || r.version < 1 || r.version > VERSION) {
+        return false;
+    }
+
+    auto mask = r.Varint();
+    if (!r.ok || (mask & ~KNOWN_FIELDS_MASK)) {
+        return false;
+    }
+
+    order = Order{};
+#define X(idx, name)           \
+    if (mask & (1ULL << idx)) { \
+        Get(r, order.name);     \
+    }
+    ORDER_CODEC_FIELDS(X)
+#undef X
+
+    // 必须恰好读完整条消息
+    return r.ok && r.p == r.end;
+}
+
+size_t OrderCodec::EncodeRaw(const Order& order, char* buf, size_t size) {
+    if (size < RAW_MESSAGE_SIZE) {
+        return 0;
+    }
+    buf[0] = (char)RAW_MAGIC;
+    buf[1] = (char)VERSION;
+    memcpy(buf + 2, &order, sizeof(Order));
+    return RAW_MESSAGE_SIZE;
+}
+
+bool OrderCodec::DecodeMessage(const char* data, size_t size, Order& order) {
+    if (size > 0 && (uint8_t)data[0] == MAGIC) {
+        return Decode(data, size, order);
+    }
+
+    // 原始结构只接受当前布局，旧布局的价格为double或缺少字段，按当前布局复制会得到错误的值
+    if (size == RAW_MESSAGE_SIZE && (uint8_t)data[0] == RAW_MAGIC && (uint8_t)data[1] == VERSION) {
+        memcpy(&order, data + 2, sizeof(Order));
+        return true;
+    }
+    return false;
+}
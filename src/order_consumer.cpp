@@ -0,0 +1,515 @@
+/**
+ * @file order_consumer.cpp
+ * @brief 订单消费引擎
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "order_consumer.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "fmt/format.h"
+#include "order_codec.h"
+#include "redispp/redis_shards.h"
+#include "utils/time_utils.h"
+
+OrderConsumer::OrderConsumer(const ConsumerOptions& options, SinkFactory sinkFactory, OrderHandler handler)
+    : _options(options), _sinkFactory(sinkFactory), _handler(handler), _queueKeys(options.queueName, options.queueCount) {
+    _options.queueCount = std::max<int64_t>(_options.queueCount, 1);
+    _options.popBatch = std::max<int64_t>(_options.popBatch, 1);
+    _options.pendingBatches = std::max<int64_t>(_options.pendingBatches, 1);
+
+    // 同一队列固定由一个工作线程处理，工作线程数超过队列数时多余的线程没有意义
+    _options.workers = std::min(std::max<int64_t>(_options.workers, 1), _options.queueCount);
+
+    // 同一消费组内的消费者以名称区分，默认名称在多台机器、多个进程间不重复
+    if (_options.stream && _options.consumerName.empty()) {
+        char host[256] = {0};
+        gethostname(host, sizeof(host) - 1);
+        _options.consumerName = fmt::format("{}_{}", host, getpid());
+    }
+}
+
+bool OrderConsumer::Run() {
+    for (int64_t i = 0; i < _options.workers; i++) {
+        _workers.emplace_back(new Worker());
+        _workers.back()->sink = _sinkFactory ? _sinkFactory(i) : std::make_shared<NullSink>();
+    }
+
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < _options.workers; i++) {
+        threads.emplace_back(&OrderConsumer::WorkLoop, this, i);
+    }
+
+    // 每个redis分片一个拉取线程，同一账户的订单只在一个分片上，各分片之间不需要保持顺序
+    auto start = library::utils::Time::Rdtsc();
+    int nodeCount = library::redis::RedisShards::Instance()->GetShardCount();
+    std::vector<char> results(nodeCount);
+    auto fetch = [this, &results](int node) { results[node] = _options.stream ? FetchStreamLoop(node) : FetchLoop(node); };
+    std::vector<std::thread> fetchers;
+    for (int node = 1; node < nodeCount; node++) {
+        fetchers.emplace_back(fetch, node);
+    }
+    fetch(0);
+    for (auto& fetcher : fetchers) {
+        fetcher.join();
+    }
+    bool ok = std::all_of(results.begin(), results.end(), [](char result) { return result; });
+
+    // 通知工作线程处理完剩余批次后退出
+    for (auto& worker : _workers) {
+        {
+            std::unique_lock<std::mutex> lock(worker->mtx);
+            worker->done = true;
+        }
+        worker->cv.notify_all();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    int64_t badCount = 0;
+    for (auto& worker : _workers) {
+        if (!worker->sink->Flush()) {
+            ok = false;
+            std::cout << "写出订单失败:" << worker->sink->GetError() << std::endl;
+        }
+        badCount += worker->badCount;
+    }
+    if (badCount > 0) {
+        ok = false;
+        std::cout << "无法解码的消息数:" << badCount << "，原样保存在各队列对应的" << DEAD_LETTER_SUFFIX << "死信队列中" << std::endl;
+    }
+    auto seconds = (library::utils::Time::Rdtsc() - start) / library::utils::Time::GetCyclesPerSec();
+
+    if (_options.workers > 1) {
+        for (int64_t i = 0; i < _options.workers; i++) {
+            std::cout << "工作线程[" << i << "]订单数:" << _workers[i]->orderCount << std::endl;
+        }
+    }
+
+    auto total = GetConsumedCount();
+    std::cout << "批量消费" << total << "笔订单" << (ok ? "成功" : "部分失败") << "，耗时" << seconds << "秒，吞吐量"
+              << (seconds > 0 ? total / seconds : 0) << "笔/秒" << std::endl;
+
+    // 推送时间由生产进程的时钟给出，跨主机时依赖时钟同步
+    LatencyHistogram latency;
+    for (auto& worker : _workers) {
+        latency.Merge(worker->latency);
+    }
+    if (latency.GetCount() > 0) {
+        auto us = [&latency](double percentile) { return latency.ValueAtPercentile(percentile) / 1000.0; };
+        std::cout << fmt::format("端到端延迟（微秒）样本数:{} p50:{:.1f} p90:{:.1f} p99:{:.1f} p99.9:{:.1f} max:{:.1f}", latency.GetCount(),
+                                 us(50), us(90), us(99), us(99.9), latency.GetMax() / 1000.0)
+                  << std::endl;
+        if (!_options.latencyPath.empty() && !latency.WritePercentiles(_options.latencyPath, 1000)) {
+            std::cout << "写入延迟分布文件失败:" << _options.latencyPath << std::endl;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief 阻塞命令（BLPOP、XREADGROUP BLOCK）必须在socket超时之前返回，否则连接会被判定为超时断开
+ * @param blockMs 期望的阻塞时长（毫秒）
+ * @param redispp 执行阻塞命令的连接池
+ * @return int64_t 限制在socket超时一半以内的阻塞时长，至少1毫秒
+ */
+static int64_t LimitBlockMs(int64_t blockMs, const library::redis::Redispp& redispp) {
+    auto config = redispp.GetRedisConfig();
+    if (config && config->socketTimeout > 0) {
+        blockMs = std::min<int64_t>(blockMs, config->socketTimeout / 2);
+    }
+    return std::max<int64_t>(blockMs, 1);
+}
+
+bool OrderConsumer::FetchLoop(int node) {
+    auto& redispp = library::redis::RedisShards::Instance()->GetShard(node);
+    int64_t blockMs = LimitBlockMs(_options.blockMs, redispp);
+
+    // BLPOP key_0 ... key_n timeout，一次阻塞监听全部队列
+    std::vector<std::string> blpopArgs;
+    blpopArgs.push_back("BLPOP");
+    blpopArgs.insert(blpopArgs.end(), _queueKeys.begin(), _queueKeys.end());
+    blpopArgs.push_back(fmt::format("{:.3f}", blockMs / 1000.0));
+
+    while (!_stop.load(std::memory_order_relaxed)) {
+        library::redis::RedisProxy redis(redispp);
+        if (redis == nullptr) {
+            std::cout << "Redis连接数不够" << std::endl;
+            if (!_options.continuous) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        try {
+            while (!_stop.load(std::memory_order_relaxed)) {
+                // 依次从每个队列批量弹出，LPOP key count（redis 6.2+）
+                int64_t popped = 0;
+                for (int64_t i = 0; i < _options.queueCount; i++) {
+                    auto elements = redis->command<sw::redis::Optional<std::vector<std::string>>>("LPOP", _queueKeys.Get(i), _options.popBatch);
+                    if (elements && !elements->empty()) {
+                        popped += elements->size();
+                        Dispatch(Batch{i, std::move(*elements), {}, node});
+                    }
+                }
+
+                if (popped > 0) {
+                    continue;
+                }
+
+                if (!_options.continuous) {
+                    return true;
+                }
+
+                // 全部队列为空，阻塞等待任一队列有数据，随后把该队列剩余的订单一并弹出
+                auto item = redis->command<sw::redis::OptionalStringPair>(blpopArgs.begin(), blpopArgs.end());
+                auto queueIdx = item ? _queueKeys.IndexOf(item->first.data(), item->first.size()) : -1;
+                if (queueIdx >= 0) {
+                    Batch batch{queueIdx, {std::move(item->second)}, {}, node};
+                    if (_options.popBatch > 1) {
+                        auto elements = redis->command<sw::redis::Optional<std::vector<std::string>>>("LPOP", _queueKeys.Get(queueIdx), _options.popBatch - 1);
+                        if (elements) {
+                            std::move(elements->begin(), elements->end(), std::back_inserter(batch.elements));
+                        }
+                    }
+                    Dispatch(std::move(batch));
+                }
+            }
+        } catch (const sw::redis::Error& e) {
+            // 出现异常，丢弃该连接
+            redis.SetInvalid();
+            std::cout << "Redis操作异常:" << e.what() << std::endl;
+            if (!_options.continuous) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool OrderConsumer::FetchStreamLoop(int node) {
+    auto& redispp = library::redis::RedisShards::Instance()->GetShard(node);
+    int64_t blockMs = LimitBlockMs(_options.blockMs, redispp);
+    auto count = std::to_string(_options.popBatch);
+
+    // XREADGROUP GROUP group consumer COUNT n [BLOCK ms] STREAMS key_0 ... key_n > ... >，一次读取全部队列
+    std::vector<std::string> readArgs = {"XREADGROUP", "GROUP", _options.group, _options.consumerName, "COUNT", count};
+    std::vector<std::string> blockArgs = readArgs;
+    blockArgs.push_back("BLOCK");
+    blockArgs.push_back(std::to_string(blockMs));
+    for (auto args : {&readArgs, &blockArgs}) {
+        args->push_back("STREAMS");
+        args->insert(args->end(), _queueKeys.begin(), _queueKeys.end());
+        args->insert(args->end(), _queueKeys.Size(), ">");
+    }
+
+    // 按队列分发XREADGROUP的结果[[key, entries], ...]
+    auto dispatchStreams = [this, node](const redisReply& reply) {
+        int64_t count = 0;
+        for (size_t i = 0; reply.type == REDIS_REPLY_ARRAY && i < reply.elements; i++) {
+            auto stream = reply.element[i];
+            if (stream->type != REDIS_REPLY_ARRAY || stream->elements < 2) {
+                continue;
+            }
+            auto queueIdx = _queueKeys.IndexOf(stream->element[0]->str, stream->element[0]->len);
+            if (queueIdx < 0) {
+                continue;
+            }
+            Batch batch{queueIdx, {}, {}, node};
+            count += ParseEntries(*stream->element[1], batch);
+            if (!batch.ids.empty()) {
+                Dispatch(std::move(batch));
+            }
+        }
+        return count;
+    };
+
+    bool prepared = false;  // 是否已创建消费组并重新处理了本消费者未确认的订单
+    auto lastReclaim = std::chrono::steady_clock::now();
+    while (!_stop.load(std::memory_order_relaxed)) {
+        library::redis::RedisProxy redis(redispp);
+        if (redis == nullptr) {
+            std::cout << "Redis连接数不够" << std::endl;
+            if (!_options.continuous) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        try {
+            if (!prepared) {
+                // 消费组从头开始读取，消费组创建之前推送的订单同样会被消费
+                for (auto& key : _queueKeys) {
+                    try {
+                        redis->command("XGROUP", "CREATE", key, _options.group, "0", "MKSTREAM");
+                    } catch (const sw::redis::ReplyError& e) {
+                        if (strncmp(e.what(), "BUSYGROUP", 9) != 0) {
+                            throw;
+                        }
+                    }
+                }
+
+                // 同名消费者重启后，先重新处理上次读取但未确认的订单
+                for (int64_t i = 0; i < _options.queueCount && !_stop.load(std::memory_order_relaxed); i++) {
+                    std::string cursor = "0";
+                    while (!_stop.load(std::memory_order_relaxed)) {
+                        auto reply = redis->command("XREADGROUP", "GROUP", _options.group, _options.consumerName, "COUNT", count, "STREAMS",
+                                                    _queueKeys.Get(i), cursor);
+                        if (reply->type != REDIS_REPLY_ARRAY || reply->elements == 0 || reply->element[0]->elements < 2) {
+                            break;
+                        }
+                        Batch batch{i, {}, {}, node};
+                        if (ParseEntries(*reply->element[0]->element[1], batch) == 0) {
+                            break;
+                        }
+                        cursor = batch.ids.back();
+                        Dispatch(std::move(batch));
+                    }
+                }
+
+                Reclaim(redis, node);
+                lastReclaim = std::chrono::steady_clock::now();
+                prepared = true;
+            }
+
+            while (!_stop.load(std::memory_order_relaxed)) {
+                auto now = std::chrono::steady_clock::now();
+                if (now - lastReclaim >= std::chrono::milliseconds(_options.claimIdleMs)) {
+                    Reclaim(redis, node);
+                    lastReclaim = now;
+                }
+
+                auto reply = redis->command(readArgs.begin(), readArgs.end());
+                if (dispatchStreams(*reply) > 0) {
+                    continue;
+                }
+
+                // 没有新订单，非持续模式下认领完超时未确认的订单后退出
+                if (!_options.continuous) {
+                    if (Reclaim(redis, node) > 0) {
+                        continue;
+                    }
+                    return true;
+                }
+
+                reply = redis->command(blockArgs.begin(), blockArgs.end());
+                dispatchStreams(*reply);
+            }
+        } catch (const sw::redis::Error& e) {
+            // 出现异常，丢弃该连接
+            redis.SetInvalid();
+            std::cout << "Redis操作异常:" << e.what() << std::endl;
+            if (!_options.continuous) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int64_t OrderConsumer::ParseEntries(const redisReply& entries, Batch& batch) {
+    if (entries.type != REDIS_REPLY_ARRAY) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < entries.elements; i++) {
+        auto entry = entries.element[i];
+        if (entry->type != REDIS_REPLY_ARRAY || entry->elements < 2 || entry->element[0]->type != REDIS_REPLY_STRING) {
+            continue;
+        }
+        batch.ids.emplace_back(entry->element[0]->str, entry->element[0]->len);
+
+        // 待确认期间被删除的消息没有字段，订单数据为空，只确认不处理
+        batch.elements.emplace_back();
+        auto fields = entry->element[1];
+        for (size_t f = 0; fields->type == REDIS_REPLY_ARRAY && f + 1 < fields->elements; f += 2) {
+            auto name = fields->element[f];
+            if (name->len == sizeof(STREAM_ORDER_FIELD) - 1 && memcmp(name->str, STREAM_ORDER_FIELD, name->len) == 0) {
+                batch.elements.back().assign(fields->element[f + 1]->str, fields->element[f + 1]->len);
+                break;
+            }
+        }
+    }
+    return (int64_t)entries.elements;
+}
+
+int64_t OrderConsumer::Reclaim(library::redis::RedisProxy& redis, int node) {
+    auto minIdle = std::to_string(_options.claimIdleMs);
+    auto count = std::to_string(_options.popBatch);
+    int64_t claimed = 0;
+    for (int64_t i = 0; i < _options.queueCount && !_stop.load(std::memory_order_relaxed); i++) {
+        // XAUTOCLAIM返回[下一个游标, 认领的消息, ...]，游标为0-0时扫描完毕
+        std::string cursor = "0-0";
+        do {
+            auto reply = redis->command("XAUTOCLAIM", _queueKeys.Get(i), _options.group, _options.consumerName, minIdle, cursor, "COUNT", count);
+            if (reply->type != REDIS_REPLY_ARRAY || reply->elements < 2 || reply->element[0]->type != REDIS_REPLY_STRING) {
+                break;
+            }
+            cursor.assign(reply->element[0]->str, reply->element[0]->len);
+
+            Batch batch{i, {}, {}, node};
+            claimed += ParseEntries(*reply->element[1], batch);
+            if (!batch.ids.empty()) {
+                Dispatch(std::move(batch));
+            }
+        } while (cursor != "0-0" && !_stop.load(std::memory_order_relaxed));
+    }
+    return claimed;
+}
+
+bool OrderConsumer::Ack(const Batch& batch) {
+    library::redis::RedisProxy redis(library::redis::RedisShards::Instance()->GetShard(batch.node));
+    if (redis == nullptr) {
+        std::cout << "Redis连接数不够，订单未确认" << std::endl;
+        return false;
+    }
+
+    // 确认和删除在一次往返中完成，删除后Stream与List一样只保留未消费的订单
+    auto key = _queueKeys.Get(batch.queueIdx);
+    try {
+        auto pipe = redis->pipeline(false);
+        pipe.xack(key, _options.group, batch.ids.begin(), batch.ids.end()).xdel(key, batch.ids.begin(), batch.ids.end());
+        pipe.exec();
+    } catch (const sw::redis::Error& e) {
+        redis.SetInvalid();
+        std::cout << "确认订单失败:" << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool OrderConsumer::DeadLetter(const Batch& batch, const std::vector<size_t>& bad) {
+    library::redis::RedisProxy redis(library::redis::RedisShards::Instance()->GetShard(batch.node));
+    if (redis == nullptr) {
+        std::cout << "Redis连接数不够，无法解码的消息未移入死信队列" << std::endl;
+        return false;
+    }
+
+    auto key = _queueKeys[batch.queueIdx] + DEAD_LETTER_SUFFIX;
+    try {
+        auto pipe = redis->pipeline(false);
+        for (auto k : bad) {
+            if (batch.ids.empty()) {
+                pipe.rpush(key, batch.elements[k]);
+            } else {
+                pipe.command("XADD", key, "*", STREAM_ORDER_FIELD, batch.elements[k], STREAM_ID_FIELD, batch.ids[k]);
+            }
+        }
+        pipe.exec();
+    } catch (const sw::redis::Error& e) {
+        redis.SetInvalid();
+        std::cout << "无法解码的消息移入死信队列失败:" << e.what() << std::endl;
+        return false;
+    }
+    std::cout << bad.size() << "条消息无法解码，已移入死信队列:" << key << std::endl;
+    return true;
+}
+
+void OrderConsumer::WorkLoop(int64_t idx) {
+    auto& worker = *_workers[idx];
+    while (true) {
+        Batch batch;
+        {
+            std::unique_lock<std::mutex> lock(worker.mtx);
+            worker.cv.wait(lock, [&worker] { return !worker.batches.empty() || worker.done; });
+            if (worker.batches.empty()) {
+                break;
+            }
+            batch = std::move(worker.batches.front());
+            worker.batches.pop_front();
+        }
+        worker.cv.notify_all();
+
+        int64_t count = 0;
+        Order order;
+        std::vector<size_t> bad;
+        for (size_t k = 0; k < batch.elements.size(); k++) {
+            auto& element = batch.elements[k];
+            if (element.empty() && !batch.ids.empty()) {
+                continue;
+            }
+            if (!OrderCodec::DecodeMessage(element.data(), element.size(), order)) {
+                bad.push_back(k);
+                continue;
+            }
+            if (order.send_time > 0) {
+                worker.latency.Record(batch.fetchTime - order.send_time);
+            }
+            if (_handler) {
+                if (batch.ids.empty()) {
+                    _handler(idx, batch.queueIdx, order);
+                } else {
+                    // 写出或确认失败的Stream消息会被重新投递，回调只执行一次，之后使用保存的处理结果
+                    // 不同分片、不同队列的消息id可能相同
+                    auto key = fmt::format("{}:{}:{}", batch.node, batch.queueIdx, batch.ids[k]);
+                    auto it = worker.unacked.find(key);
+                    if (it == worker.unacked.end()) {
+                        _handler(idx, batch.queueIdx, order);
+                        worker.unacked.emplace(std::move(key), order);
+                    } else {
+                        order = it->second;
+                    }
+                }
+            }
+            worker.sink->Write(order);
+            ++count;
+        }
+
+        // 无法解码的消息先移入死信队列再确认，Stream消息移入失败时整批不确认，超时后重新投递
+        if (!bad.empty()) {
+            if (!DeadLetter(batch, bad) && !batch.ids.empty()) {
+                continue;
+            }
+            worker.badCount += bad.size();
+        }
+        if (batch.ids.empty()) {
+            if (!worker.sink->FlushIfFull()) {
+                std::cout << "写出订单失败:" << worker.sink->GetError() << std::endl;
+            }
+        } else if (worker.sink->Flush()) {
+            // 订单写出到文件后才确认，进程崩溃时未写出的订单由其他消费者认领重新处理
+            if (Ack(batch) && _handler) {
+                for (auto& id : batch.ids) {
+                    worker.unacked.erase(fmt::format("{}:{}:{}", batch.node, batch.queueIdx, id));
+                }
+            }
+        } else {
+            // 写出失败时不确认，整批订单留在待确认列表中，超时后由XAUTOCLAIM重新投递
+            std::cout << "写出订单失败，" << batch.ids.size() << "条消息未确认:" << worker.sink->GetError() << std::endl;
+            continue;
+        }
+        worker.orderCount += count;
+        _consumed.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+void OrderConsumer::Dispatch(Batch&& batch) {
+    // 在等待工作线程之前取时间，延迟只包含订单在redis中排队的时间
+    batch.fetchTime = library::utils::Time::NowNano();
+    auto& worker = *_workers[batch.queueIdx % _options.workers];
+    {
+        std::unique_lock<std::mutex> lock(worker.mtx);
+        worker.cv.wait(lock, [this, &worker] { return (int64_t)worker.batches.size() < _options.pendingBatches; });
+        worker.batches.push_back(std::move(batch));
+    }
+    worker.cv.notify_all();
+}
@@ -0,0 +1,387 @@
+/**
+ * @file order_producer.cpp
+ * @brief 订单生产者
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "order_producer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "common_def.h"
+#include "order_codec.h"
+#include "redispp/async_redis.h"
+#include "redispp/id_allocator.h"
+#include "redispp/redis_shards.h"
+#include "redispp/redispp.h"
+#include "redispp/script_manager.h"
+#include "utils/exception_utils.h"
+#include "utils/time_utils.h"
+
+// 脚本推送时订单编号的占位符，由脚本替换为redis分配的编号，长度决定编号的最大位数
+static const char ORDER_ID_PLACEHOLDER[] = "###############";
+
+/**
+ * @brief 初始化测试订单模板，账户、证券、买卖方向、数量和价格由OrderWorkload逐笔填写
+ * @param order 订单
+ */
+static void InitOrder(Order& order) {
+    order.branch_no = 30;
+    strcpy(order.password, "abc123");
+    order.batch_no = 0;
+    strcpy(order.stock_account, "B880820006");
+    order.op_entrust_way = '1';  // 限价委托
+    order.entrust_prop = '0';
+    order.registe_sure_flag = '1';
+}
+
+OrderProducer::OrderProducer(const ProducerOptions& options)
+    : _options(options), _queueKeys(options.queueName, options.queueCount), _workload(options.workload, options.accountCount) {
+    _options.accountCount = std::max<int64_t>(_options.accountCount, 1);
+    _options.queueCount = _queueKeys.Size();
+
+    // 线程按队列分片，线程数超过队列数时多余的线程没有可写的队列
+    _options.threads = std::min(std::max<int64_t>(_options.threads, 1), _options.queueCount);
+}
+
+bool OrderProducer::Run() {
+    std::vector<ProducerStats> stats(_options.threads);
+    std::vector<std::thread> workers;
+
+    // 一次算出每笔订单的账户及负责的线程，线程只遍历自己的订单，每笔订单的账户只抽样一次
+    std::vector<std::vector<ShardOrder>> shardOrders(_options.threads);
+    for (int64_t i = 0; i < _options.orderCount; i++) {
+        auto account = _workload.AccountIndex(i);
+        int64_t queueIdx = (FUND_ACCOUNT_BASE + account) % _options.queueCount;
+        shardOrders[queueIdx % _options.threads].push_back({i, account});
+    }
+
+    auto start = library::utils::Time::Rdtsc();
+    for (int64_t t = 0; t < _options.threads; t++) {
+        workers.emplace_back(&OrderProducer::RunShard, this, t, _options.threads, std::cref(shardOrders[t]), std::ref(stats[t]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto seconds = (library::utils::Time::Rdtsc() - start) / library::utils::Time::GetCyclesPerSec();
+
+    bool ok = true;
+    int64_t total = 0;
+    auto cyclesPerUs = library::utils::Time::GetCyclesPerSec() / 1e6;
+    for (int64_t t = 0; t < _options.threads; t++) {
+        auto& s = stats[t];
+        total += s.orderCount;
+        if (!s.error.empty()) {
+            ok = false;
+            std::cout << "线程[" << t << "]Redis操作异常:" << s.error << std::endl;
+        }
+
+        if (_options.threads > 1) {
+            std::cout << "线程[" << t << "]队列数:" << s.queueCount << ",订单数:" << s.orderCount << ",耗时" << s.seconds
+                      << "秒，吞吐量" << (s.seconds > 0 ? s.orderCount / s.seconds : 0) << "笔/秒" << std::endl;
+        }
+        if (s.batchCount > 0) {
+            std::cout << "线程[" << t << "]批次数:" << s.batchCount << ",每批订单数:" << _options.batch
+                      << ",批次耗时(us) min:" << s.minCycles / cyclesPerUs
+                      << " avg:" << s.sumCycles / cyclesPerUs / s.batchCount
+                      << " max:" << s.maxCycles / cyclesPerUs << std::endl;
+        }
+    }
+
+    if (_options.script) {
+        std::cout << "脚本因NOSCRIPT重新加载" << library::redis::ScriptManager::Instance()->GetReloadCount() << "次" << std::endl;
+    }
+    std::cout << "批量创建" << total << "笔订单" << (ok ? "成功" : "部分失败") << "，线程数" << _options.threads << "，耗时" << seconds
+              << "秒，吞吐量" << (seconds > 0 ? total / seconds : 0) << "笔/秒" << std::endl;
+
+    if (_options.pace.rate > 0) {
+        // 实际吞吐低于计划或最大落后持续增大时，说明计划速率已超过饱和点，延迟中包含排队时间
+        LatencyHistogram ackLatency;
+        int64_t maxLagNs = 0;
+        int64_t lateCount = 0;
+        for (auto& s : stats) {
+            ackLatency.Merge(s.ackLatency);
+            maxLagNs = std::max(maxLagNs, s.maxLagNs);
+            lateCount += s.lateCount;
+        }
+        std::cout << "开环限速计划" << _options.pace.rate << "笔/秒（突发" << _options.pace.burst << "笔，爬坡"
+                  << _options.pace.rampSeconds << "秒），落后计划最大" << maxLagNs / 1000 << "微秒，落后超过1毫秒"
+                  << lateCount << "笔" << std::endl;
+        if (ackLatency.GetCount() > 0) {
+            std::cout << "推送确认延迟（从计划发送时间起，微秒）样本数:" << ackLatency.GetCount()
+                      << " p50:" << ackLatency.ValueAtPercentile(50) / 1000.0
+                      << " p90:" << ackLatency.ValueAtPercentile(90) / 1000.0
+                      << " p99:" << ackLatency.ValueAtPercentile(99) / 1000.0
+                      << " p99.9:" << ackLatency.ValueAtPercentile(99.9) / 1000.0
+                      << " max:" << ackLatency.GetMax() / 1000.0 << std::endl;
+        }
+    }
+    return ok;
+}
+
+void OrderProducer::RunShard(int64_t shard, int64_t shardCount, const std::vector<ShardOrder>& orders, ProducerStats& stats) {
+    auto start = library::utils::Time::Rdtsc();
+    stats.queueCount = (_options.queueCount - shard + shardCount - 1) / shardCount;
+
+    // 每个redis分片一个连接，订单按资产账户一致性哈希到分片，消费者从全部分片读取
+    auto& nodes = *library::redis::RedisShards::Instance();
+    int nodeCount = nodes.GetShardCount();
+    std::vector<std::unique_ptr<library::redis::RedisProxy>> redis;
+    for (int n = 0; n < nodeCount; n++) {
+        redis.emplace_back(new library::redis::RedisProxy(nodes.GetShard(n)));
+        if (*redis.back() == nullptr) {
+            stats.error = "Redis连接数不够";
+            return;
+        }
+    }
+    int node = 0;  // 当前操作的分片，出错时丢弃该分片的连接
+
+    Order order;
+    InitOrder(order);
+
+    // 编码缓冲区，紧凑编码时每笔订单编码到这里再推送
+    char buf[OrderCodec::MAX_ENCODED_SIZE];
+    auto pack = [this, &order, &buf]() {
+        if (_options.compact) {
+            return sw::redis::StringView(buf, OrderCodec::Encode(order, buf, sizeof(buf)));
+        }
+        return sw::redis::StringView(buf, OrderCodec::EncodeRaw(order, buf, sizeof(buf)));
+    };
+
+    // 订单编号按号段从redis预留，本地分配，各线程的号段互不重叠
+    // 脚本推送时编号由脚本在redis中分配，订单中只放占位符
+    library::redis::IdAllocator idAllocator(ORDER_NO_KEY, _options.idBlock);
+    library::redis::LuaScriptPtr script;
+    if (_options.script) {
+        script = library::redis::ScriptManager::Instance()->Register(library::redis::ALLOC_PUSH_SCRIPT_NAME,
+                                                                     library::redis::ALLOC_PUSH_SCRIPT);
+        strcpy(order.order_id, ORDER_ID_PLACEHOLDER);
+    }
+
+    auto queueCount = _options.queueCount;
+    // 开环限速：订单按计划时间放行，延迟从计划时间起算，发送落后时不会少算排队时间
+    // 总速率按本线程分到的订单比例分配，账户集中在少数队列时各线程的计划仍能合成总速率
+    auto pace = _options.pace;
+    pace.rate = _options.orderCount > 0 ? pace.rate * orders.size() / _options.orderCount : 0;
+    RatePacer pacer(pace);
+    auto fill = [this, &order, &idAllocator, &script, &pacer](const ShardOrder& shardOrder) {
+        _workload.Fill(shardOrder.index, shardOrder.account, order);
+        if (!script) {
+            strcpy(order.order_id, std::to_string(idAllocator.Next()).c_str());
+        }
+        order.send_time = pacer.Wait();  // 限速时为计划发送时间，否则为当前时间，消费端据此统计端到端延迟
+    };
+
+    auto recordAck = [&stats, &pacer](const int64_t* sendTimes, int64_t n) {
+        if (pacer.Enabled()) {
+            auto now = library::utils::Time::NowNano();
+            for (int64_t k = 0; k < n; k++) {
+                stats.ackLatency.Record(now - sendTimes[k]);
+            }
+        }
+    };
+    std::vector<int64_t> sendTimes(std::max<int64_t>(_options.batch, 1));
+    pacer.Start();
+
+    try {
+        if (_options.asyncWindow > 0) {
+            // 异步模式：一条连接上保持asyncWindow条RPUSH在途，编码与网络往返重叠
+            // 每个分片的客户端有各自的事件循环线程，回调只修改本分片的计数，全部Stop返回后再合并到stats
+            struct ReplyCount {
+                int64_t orderCount = 0;  // 推送成功的订单数
+                std::string error;       // 第一个出错信息
+            };
+            std::vector<ReplyCount> replyCounts(nodeCount);
+            std::vector<library::redis::AsyncCallback> onReply;
+            std::vector<std::unique_ptr<library::redis::AsyncRedis>> async;
+            for (int n = 0; n < nodeCount; n++) {
+                auto& count = replyCounts[n];
+                onReply.emplace_back([&count](library::redis::AsyncReply& reply) {
+                    if (reply.ok) {
+                        ++count.orderCount;
+                    } else if (count.error.empty()) {
+                        count.error = reply.error;
+                    }
+                });
+                async.emplace_back(new library::redis::AsyncRedis());
+                async.back()->Start(nodes.GetShard(n).GetSentinelConfigs(), nodes.GetShard(n).GetRedisConfig());
+            }
+
+            for (auto& shardOrder : orders) {
+                int64_t queueIdx = (FUND_ACCOUNT_BASE + shardOrder.account) % queueCount;
+                fill(shardOrder);
+                auto p = nodes.Locate(order.fund_account);
+                auto& client = *async[p];
+                while (client.GetInflight() >= _options.asyncWindow) {
+                    std::this_thread::yield();
+                }
+                auto key = _queueKeys.Get(queueIdx);
+                if (_options.stream) {
+                    client.Command({"XADD", key, "*", STREAM_ORDER_FIELD, pack()}, onReply[p]);
+                } else {
+                    client.Command({"RPUSH", key, pack()}, onReply[p]);
+                }
+            }
+            for (auto& client : async) {
+                while (client->GetInflight() > 0) {
+                    std::this_thread::yield();
+                }
+                client->Stop();
+            }
+            for (auto& count : replyCounts) {
+                stats.orderCount += count.orderCount;
+                if (stats.error.empty()) {
+                    stats.error = count.error;
+                }
+            }
+        } else if (_options.batch <= 0) {
+            std::vector<sw::redis::StringView> keys;
+            std::vector<sw::redis::StringView> args;
+            for (auto& shardOrder : orders) {
+                int64_t queueIdx = (FUND_ACCOUNT_BASE + shardOrder.account) % queueCount;
+
+                // 开启autoPipeline时与其他线程合并发送
+                fill(shardOrder);
+                node = nodes.Locate(order.fund_account);
+                auto key = _queueKeys.Get(queueIdx);
+                if (script) {
+                    keys.assign({ORDER_NO_KEY, ACCOUNT_ORDER_COUNT_KEY, key});
+                    args.assign({ORDER_ID_PLACEHOLDER, "1", order.fund_account, pack()});
+                    library::redis::ScriptManager::Instance()->Eval(*redis[node], *script, keys, args);
+                } else if (_options.stream) {
+                    redis[node]->Command("XADD", key, "*", STREAM_ORDER_FIELD, pack());
+                } else {
+                    redis[node]->Command("RPUSH", key, pack());
+                }
+                ++stats.orderCount;
+                recordAck(&order.send_time, 1);
+            }
+        } else if (script) {
+            // 脚本批量模式：每批一条EVALSHA，在redis中原子地分配编号并推送到本线程负责的各个队列
+            // 队列q在本线程队列中的序号为q / shardCount，脚本参数中的序号从1开始
+            std::vector<sw::redis::StringView> keys = {ORDER_NO_KEY, ACCOUNT_ORDER_COUNT_KEY};
+            std::vector<std::string> queueNos;
+            for (int64_t q = shard; q < queueCount; q += shardCount) {
+                keys.push_back(_queueKeys.Get(q));
+                queueNos.push_back(std::to_string(keys.size() - 2));
+            }
+
+            std::vector<std::string> accounts(_options.batch);
+            std::vector<std::string> payloads(_options.batch);
+            std::vector<sw::redis::StringView> args;
+            args.reserve(1 + 3 * _options.batch);
+            stats.minCycles = UINT64_MAX;
+            size_t k = 0;
+            while (k < orders.size()) {
+                auto batchStart = library::utils::Time::Rdtsc();
+                args.assign(1, ORDER_ID_PLACEHOLDER);
+                int64_t n = 0;
+                for (; k < orders.size() && n < _options.batch; k++) {
+                    auto& shardOrder = orders[k];
+                    int64_t queueIdx = (FUND_ACCOUNT_BASE + shardOrder.account) % queueCount;
+                    // 限速时只发送已到计划时间的订单，不为凑满一批而推迟
+                    if (n > 0 && !pacer.Due()) {
+                        break;
+                    }
+
+                    fill(shardOrder);
+                    sendTimes[n] = order.send_time;
+                    auto data = pack();
+                    accounts[n].assign(order.fund_account);
+                    payloads[n].assign(data.data(), data.size());
+                    args.emplace_back(queueNos[queueIdx / shardCount]);
+                    args.emplace_back(accounts[n]);
+                    args.emplace_back(payloads[n]);
+                    ++n;
+                }
+                if (n == 0) {
+                    break;
+                }
+                library::redis::ScriptManager::Instance()->Eval(*redis[node], *script, keys, args);
+                stats.orderCount += n;
+                recordAck(sendTimes.data(), n);
+
+                auto cycles = library::utils::Time::Rdtsc() - batchStart;
+                stats.minCycles = std::min(stats.minCycles, cycles);
+                stats.maxCycles = std::max(stats.maxCycles, cycles);
+                stats.sumCycles += cycles;
+                ++stats.batchCount;
+            }
+        } else {
+            // 批量模式：每批通过pipeline一次往返发送全部RPUSH，每个分片一个pipeline
+            std::vector<sw::redis::Pipeline> pipes;
+            std::vector<int64_t> pending(nodeCount);
+            for (auto& proxy : redis) {
+                pipes.emplace_back((*proxy)->pipeline(false));
+            }
+            stats.minCycles = UINT64_MAX;
+            size_t k = 0;
+            while (k < orders.size()) {
+                auto batchStart = library::utils::Time::Rdtsc();
+                int64_t n = 0;
+                for (; k < orders.size() && n < _options.batch; k++) {
+                    auto& shardOrder = orders[k];
+                    int64_t queueIdx = (FUND_ACCOUNT_BASE + shardOrder.account) % queueCount;
+                    if (n > 0 && !pacer.Due()) {
+                        break;
+                    }
+
+                    fill(shardOrder);
+                    sendTimes[n] = order.send_time;
+                    auto p = nodes.Locate(order.fund_account);
+                    auto key = _queueKeys.Get(queueIdx);
+                    if (_options.stream) {
+                        pipes[p].command("XADD", key, "*", STREAM_ORDER_FIELD, pack());
+                    } else {
+                        pipes[p].rpush(key, pack());
+                    }
+                    ++pending[p];
+                    ++n;
+                }
+                if (n == 0) {
+                    break;
+                }
+                for (int p = 0; p < nodeCount; p++) {
+                    if (pending[p] > 0) {
+                        node = p;
+                        pipes[p].exec();
+                        pending[p] = 0;
+                    }
+                }
+                stats.orderCount += n;
+                recordAck(sendTimes.data(), n);
+
+                auto cycles = library::utils::Time::Rdtsc() - batchStart;
+                stats.minCycles = std::min(stats.minCycles, cycles);
+                stats.maxCycles = std::max(stats.maxCycles, cycles);
+                stats.sumCycles += cycles;
+                ++stats.batchCount;
+            }
+        }
+    } catch (const library::redis::PipelinePeerError& e) {
+        // 自动合并时其他线程发送本命令的连接出错，本线程的连接未被使用，仍然有效
+        stats.error = e.what();
+    } catch (const sw::redis::Error& e) {
+        // 出现异常，丢弃该连接
+        redis[node]->SetInvalid();
+        stats.error = e.what();
+    } catch (const library::utils::Exception& e) {
+        // 异步客户端启动失败
+        stats.error = e.what();
+    }
+
+    stats.maxLagNs = pacer.GetMaxLagNs();
+    stats.lateCount = pacer.GetLateCount();
+    stats.seconds = (library::utils::Time::Rdtsc() - start) / library::utils::Time::GetCyclesPerSec();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file order_sink.cpp
+ * @brief 消费订单的输出端
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "order_sink.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "utils/exception_utils.h"
+
+BufferedFileSink::BufferedFileSink(const std::string& path, size_t bufferSize)
+    : _path(path), _bufferSize(bufferSize) {
+    _fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, (mode_t)0644);
+    if (_fd < 0) {
+        throw library::utils::Exception("failed to open sink file " + path);
+    }
+
+    struct stat st;
+    _emptyFile = fstat(_fd, &st) == 0 && st.st_size == 0;
+    _buffer.reserve(_bufferSize);
+}
+
+BufferedFileSink::~BufferedFileSink() {
+    Flush();
+    if (_fd >= 0) {
+        close(_fd);
+    }
+}
+
+bool BufferedFileSink::FlushIfFull() { return _buffer.size() < _bufferSize || Flush(); }
+
+bool BufferedFileSink::Flush() {
+    const char* data = _buffer.data();
+    size_t left = _buffer.size();
+    while (left > 0) {
+        auto n = write(_fd, data, left);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            // 写入0字节按磁盘已满处理，避免死循环
+            _error = "failed to write sink file " + _path + ": " + strerror(n < 0 ? errno : ENOSPC);
+            _buffer.clear();
+            return false;
+        }
+        data += n;
+        left -= n;
+    }
+    _buffer.clear();
+    return true;
+}
+
+CsvSink::CsvSink(const std::string& path, size_t bufferSize)
+    : BufferedFileSink(path, bufferSize) {
+    if (IsEmptyFile()) {
+        fmt::format_to(std::back_inserter(_buffer), "order_id,fund_account,exchange_type,stock_code,entrust_bs,entrust_price,entrust_amount,entrust_no,entrust_status,deal_price,deal_amount\n");
+    }
+}
+
+void CsvSink::Write(const Order& order) {
+    fmt::format_to(std::back_inserter(_buffer), "{},{},{},{},{},", order.order_id, order.fund_account, order.exchange_type,
+                   order.stock_code, order.entrust_bs);
+
+    // 定点价格直接格式化到缓冲区
+    char price[32];
+    _buffer.append(price, order.entrust_price.ToChars(price, price + sizeof(price)));
+    fmt::format_to(std::back_inserter(_buffer), ",{},{},{},", order.entrust_amount, order.entrust_no,
+                   order.entrust_status ? order.entrust_status : '0');
+    _buffer.append(price, order.deal_price.ToChars(price, price + sizeof(price)));
+    fmt::format_to(std::back_inserter(_buffer), ",{}\n", order.deal_amount);
+}
+
+BinarySink::BinarySink(const std::string& path, size_t bufferSize)
+    : BufferedFileSink(path, bufferSize) {
+}
+
+void BinarySink::Write(const Order& order) {
+    _buffer.append((const char*)&order, (const char*)&order + sizeof(order));
+}
+
+SinkFactory MakeSinkFactory(const std::string& type, const std::string& pathPrefix, size_t bufferSize) {
+    if (type == "null") {
+        return [](int64_t) { return std::make_shared<NullSink>(); };
+    } else if (type == "csv") {
+        return [=](int64_t worker) { return std::make_shared<CsvSink>(fmt::format("{}_{}.csv", pathPrefix, worker), bufferSize); };
+    } else if (type == "binary") {
+        return [=](int64_t worker) { return std::make_shared<BinarySink>(fmt::format("{}_{}.bin", pathPrefix, worker), bufferSize); };
+    }
+    return nullptr;
+}
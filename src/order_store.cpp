@@ -0,0 +1,116 @@
+/**
+ * @file order_store.cpp
+ * @brief 订单冷热分离存储
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "order_store.h"
+
+#include <cstring>
+
+// 热数据字段，Order中新增字段时需加入热数据或冷数据其中之一
+#define ORDER_CORE_FIELDS(X) \
+    X(entrust_price)         \
+    X(deal_price)            \
+    X(freeze_money)          \
+    X(deal_amount)           \
+    X(cancel_amount)         \
+    X(entrust_amount)        \
+    X(entrust_time)          \
+    X(update_time)           \
+    X(exchange_type)         \
+    X(entrust_bs)            \
+    X(entrust_prop)          \
+    X(entrust_status)
+
+// 冷数据中的数值字段
+#define ORDER_COLD_VALUES(X) \
+    X(branch_no)             \
+    X(batch_no)              \
+    X(op_entrust_way)        \
+    X(entrust_money)         \
+    X(registe_sure_flag)     \
+    X(init_date)             \
+    X(entrust_no)            \
+    X(report_no)             \
+    X(fees)                  \
+    X(send_time)
+
+// 冷数据中的字符串字段
+#define ORDER_COLD_STRINGS(X) \
+    X(client_id)              \
+    X(fund_account)           \
+    X(password)               \
+    X(order_id)               \
+    X(stock_account)          \
+    X(stock_code)             \
+    X(seat_no)                \
+    X(remark)
+
+#define COPY_VALUE(name) to.name = from.name;
+#define COPY_STRING(name)                                                             \
+    static_assert(sizeof(to.name) == sizeof(from.name), "field size mismatch: " #name); \
+    memcpy(to.name, from.name, sizeof(to.name));
+
+static void Split(const Order& from, OrderCore& core, OrderCold& cold) {
+    {
+        auto& to = core;
+        ORDER_CORE_FIELDS(COPY_VALUE)
+    }
+    {
+        auto& to = cold;
+        ORDER_COLD_VALUES(COPY_VALUE)
+        ORDER_COLD_STRINGS(COPY_STRING)
+    }
+
+    core.account = ParseFundAccount(from.fund_account);
+}
+
+static void Merge(const OrderCore& core, const OrderCold& cold, Order& to) {
+    {
+        auto& from = core;
+        ORDER_CORE_FIELDS(COPY_VALUE)
+    }
+    {
+        auto& from = cold;
+        ORDER_COLD_VALUES(COPY_VALUE)
+        ORDER_COLD_STRINGS(COPY_STRING)
+    }
+}
+
+#undef COPY_VALUE
+#undef COPY_STRING
+
+void OrderStore::Reserve(size_t count) {
+    _cores.reserve(count);
+    _colds.reserve(count);
+}
+
+uint32_t OrderStore::Add(const Order& order) {
+    auto index = (uint32_t)_cores.size();
+    _cores.emplace_back();
+    _colds.emplace_back();
+    Split(order, _cores.back(), _colds.back());
+    return index;
+}
+
+void OrderStore::Load(uint32_t index, Order& order) const {
+    Merge(_cores[index], _colds[index], order);
+}
+
+void OrderStore::Store(uint32_t index, const Order& order) {
+    Split(order, _cores[index], _colds[index]);
+}
+
+void OrderStore::Clear() {
+    _cores.clear();
+    _colds.clear();
+}
@@ -0,0 +1,280 @@
+/**
+ * @file order_workload.cpp
+ * @brief 测试订单生成器
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "order_workload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "fmt/format.h"
+#include "matching_engine.h"
+#include "utils/exception_utils.h"
+#include "xmf/xmf_json.h"
+
+static const uint64_t ACCOUNT_STREAM = 1;  // 账户抽样的随机数流
+static const uint64_t ORDER_STREAM = 2;    // 其他字段的随机数流
+static const int BAND_PERCENT_MAX = 10;    // 撮合引擎以首笔委托价上下20%建簿，价格范围不超过10%时其余委托都在簿内
+
+/**
+ * @brief splitmix64，返回下一个64位随机数
+ * @param state 随机数状态
+ */
+static uint64_t NextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief 返回[0, 1)内均匀分布的随机数
+ * @param state 随机数状态
+ */
+static double NextUniform(uint64_t& state) { return (NextRandom(state) >> 11) * 0x1.0p-53; }
+
+/**
+ * @brief 第i笔订单某个随机数流的初始状态，只由种子、序号和流决定
+ */
+static uint64_t StreamState(uint64_t seed, int64_t i, uint64_t stream) {
+    uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    state ^= NextRandom(state) + (uint64_t)i * 0x9E3779B97F4A7C15ULL;
+    return state;
+}
+
+// log1p(x)/x，x接近0时用泰勒展开
+static double Helper1(double x) { return std::fabs(x) > 1e-8 ? std::log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x)); }
+
+// expm1(x)/x，x接近0时用泰勒展开
+static double Helper2(double x) { return std::fabs(x) > 1e-8 ? std::expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x)); }
+
+ZipfSampler::ZipfSampler(int64_t count, double exponent)
+    : _count(std::max<int64_t>(count, 1)), _exponent(exponent) {
+    _hIntegralX1 = HIntegral(1.5) - 1;
+    _hIntegralN = HIntegral(_count + 0.5);
+    _s = 2 - HIntegralInverse(HIntegral(2.5) - H(2));
+}
+
+double ZipfSampler::H(double x) const { return std::exp(-_exponent * std::log(x)); }
+
+double ZipfSampler::HIntegral(double x) const {
+    auto logX = std::log(x);
+    return Helper2((1 - _exponent) * logX) * logX;
+}
+
+double ZipfSampler::HIntegralInverse(double x) const {
+    auto t = std::max(x * (1 - _exponent), -1.0);
+    return std::exp(Helper1(t) * x);
+}
+
+int64_t ZipfSampler::Sample(uint64_t& state) const {
+    // 在H的积分上均匀取点再反解，落在直方柱外的点拒绝后重取，接受率很高
+    while (true) {
+        auto u = _hIntegralN + NextUniform(state) * (_hIntegralX1 - _hIntegralN);
+        auto x = HIntegralInverse(u);
+        auto k = std::min(std::max<int64_t>((int64_t)(x + 0.5), 1), _count);
+        if (k - x <= _s || u >= HIntegral(k + 0.5) - H((double)k)) {
+            return k;
+        }
+    }
+}
+
+OrderWorkload::OrderWorkload(const WorkloadProfile& profile, int64_t accountCount)
+    : _profile(profile), _accountCount(std::max<int64_t>(accountCount, 1)) {
+    if (_profile.symbols.empty()) {
+        SymbolProfile symbol;
+        symbol.code = "600028";
+        symbol.refPrice = Price::FromRaw(42600);  // 4.26
+        _profile.symbols.push_back(symbol);
+    }
+    _profile.lot = std::max<int64_t>(_profile.lot, 1);
+    _profile.minLots = std::max<int64_t>(_profile.minLots, 1);
+    _profile.maxLots = std::max(_profile.maxLots, _profile.minLots);
+
+    // 排名乘以与账户数互质的数再取模是一个置换，相邻排名的热点账户落在不同队列
+    _accountStride = (int64_t)(0x9E3779B97F4A7C15ULL % (uint64_t)_accountCount);
+    while (_accountCount > 1 && std::gcd(_accountStride, _accountCount) != 1) {
+        ++_accountStride;
+    }
+    if (_profile.accountSkew > 0) {
+        _accountZipf.reset(new ZipfSampler(_accountCount, _profile.accountSkew));
+    }
+    if (_profile.amountSkew > 0) {
+        _lotZipf.reset(new ZipfSampler(_profile.maxLots - _profile.minLots + 1, _profile.amountSkew));
+    }
+
+    double total = 0;
+    for (size_t s = 0; s < _profile.symbols.size(); s++) {
+        auto weight = _profile.symbols[s].weight;
+        total += weight > 0 ? weight : std::pow(s + 1.0, -_profile.symbolSkew);
+        _symbolWeights.push_back(total);
+    }
+}
+
+int64_t OrderWorkload::AccountIndex(int64_t i) const {
+    if (!_accountZipf) {
+        return i % _accountCount;
+    }
+    auto state = StreamState(_profile.seed, i, ACCOUNT_STREAM);
+    return (int64_t)((uint64_t)(_accountZipf->Sample(state) - 1) * (uint64_t)_accountStride % (uint64_t)_accountCount);
+}
+
+void OrderWorkload::Fill(int64_t i, int64_t account, Order& order) const {
+    *fmt::format_to_n(order.client_id, sizeof(order.client_id) - 1, "{}", CLIENT_ID_BASE + account).out = '\0';
+    *fmt::format_to_n(order.fund_account, sizeof(order.fund_account) - 1, "{}", FUND_ACCOUNT_BASE + account).out = '\0';
+
+    auto state = StreamState(_profile.seed, i, ORDER_STREAM);
+    size_t s = 0;
+    if (_symbolWeights.size() > 1) {
+        auto pick = NextUniform(state) * _symbolWeights.back();
+        s = std::min<size_t>(std::upper_bound(_symbolWeights.begin(), _symbolWeights.end(), pick) - _symbolWeights.begin(),
+                             _symbolWeights.size() - 1);
+    }
+    auto& symbol = _profile.symbols[s];
+    order.exchange_type = symbol.exchangeType;
+    strcpy(order.stock_code, symbol.code.c_str());
+
+    if (_profile.buyRatio < 0) {
+        order.entrust_bs = i / _accountCount % 2 ? '2' : '1';  // 每个账户买卖交替，撮合时能够成交
+    } else {
+        order.entrust_bs = NextUniform(state) < _profile.buyRatio ? '1' : '2';
+    }
+
+    int64_t lots = _profile.minLots;
+    if (_lotZipf) {
+        lots += _lotZipf->Sample(state) - 1;
+    } else if (_profile.maxLots > _profile.minLots) {
+        lots += (int64_t)(NextRandom(state) % (uint64_t)(_profile.maxLots - _profile.minLots + 1));
+    }
+    order.entrust_amount = (int)(lots * _profile.lot);
+
+    // 价格在参考价上下bandPercent内按最小变动单位均匀分布
+    auto refTick = std::max<int64_t>(symbol.refPrice.Raw() / OrderBook::TICK_RAW, 1);
+    auto bandTicks = refTick * symbol.bandPercent / 100;
+    auto tick = refTick;
+    if (bandTicks > 0) {
+        tick += (int64_t)(NextRandom(state) % (uint64_t)(2 * bandTicks + 1)) - bandTicks;
+    }
+    order.entrust_price = bandTicks > 0 ? Price::FromRaw(std::max<int64_t>(tick, 1) * OrderBook::TICK_RAW) : symbol.refPrice;
+}
+
+/**
+ * @brief 查找可选的配置项
+ * @param objectPtr 配置对象
+ * @param key 配置项名称
+ * @return library::xmf::XmfValuePtr 配置项，不存在时为空
+ */
+static library::xmf::XmfValuePtr FindItem(const library::xmf::XmfValuePtr& objectPtr, const char* key) {
+    auto object = std::dynamic_pointer_cast<library::xmf::XmfObject>(objectPtr);
+    return object ? object->Find(key) : nullptr;
+}
+
+/**
+ * @brief 读取可选的数值配置项
+ */
+static double GetNumber(const library::xmf::XmfValuePtr& objectPtr, const char* key, double defaultValue) {
+    auto itemPtr = FindItem(objectPtr, key);
+    return itemPtr ? itemPtr->ToDouble() : defaultValue;
+}
+
+/**
+ * @brief 读取证券配置中的交易所类别和价格范围
+ */
+static void ReadSymbolCommon(const library::xmf::XmfValuePtr& objectPtr, SymbolProfile& symbol) {
+    auto exchangePtr = FindItem(objectPtr, "exchange_type");
+    if (exchangePtr) {
+        auto exchangeType = exchangePtr->ToString();
+        if (exchangeType.size() != 1) {
+            throw library::utils::Exception("workload exchange_type must be a single character: " + exchangeType);
+        }
+        symbol.exchangeType = exchangeType[0];
+    }
+    symbol.bandPercent = (int)GetNumber(objectPtr, "band_percent", 0);
+    if (symbol.bandPercent < 0 || symbol.bandPercent > BAND_PERCENT_MAX) {
+        throw library::utils::Exception(fmt::format("workload band_percent must be within 0~{}", BAND_PERCENT_MAX));
+    }
+}
+
+WorkloadProfile OrderWorkload::LoadProfile(const std::string& path) {
+    library::xmf::XmfJson xmfJson;
+    auto dataPtr = xmfJson.Read(path.c_str());
+    if (!dataPtr) {
+        throw library::utils::Exception("failed to read workload profile " + path + ": " + xmfJson.GetErrorMsg());
+    }
+
+    WorkloadProfile profile;
+    profile.seed = (uint64_t)GetNumber(dataPtr, "seed", (double)profile.seed);
+    profile.accountSkew = GetNumber(dataPtr, "account_skew", profile.accountSkew);
+    profile.buyRatio = GetNumber(dataPtr, "buy_ratio", profile.buyRatio);
+    profile.symbolSkew = GetNumber(dataPtr, "symbol_skew", profile.symbolSkew);
+    if (profile.accountSkew < 0 || profile.symbolSkew < 0 || profile.buyRatio > 1) {
+        throw library::utils::Exception("workload account_skew and symbol_skew must not be negative, buy_ratio must not exceed 1");
+    }
+
+    auto amountPtr = FindItem(dataPtr, "amount");
+    if (amountPtr) {
+        profile.lot = (int64_t)GetNumber(amountPtr, "lot", (double)profile.lot);
+        profile.minLots = (int64_t)GetNumber(amountPtr, "min_lots", (double)profile.minLots);
+        profile.maxLots = (int64_t)GetNumber(amountPtr, "max_lots", (double)profile.maxLots);
+        profile.amountSkew = GetNumber(amountPtr, "skew", profile.amountSkew);
+        if (profile.lot < 1 || profile.minLots < 1 || profile.maxLots < profile.minLots || profile.amountSkew < 0 ||
+            profile.lot * profile.maxLots > INT32_MAX) {
+            throw library::utils::Exception("workload amount requires lot >= 1, 1 <= min_lots <= max_lots and skew >= 0");
+        }
+    }
+
+    // 逐个列出的证券在前，批量生成的证券在后，symbolSkew按这个顺序排名
+    auto symbolsPtr = FindItem(dataPtr, "symbols");
+    if (symbolsPtr) {
+        for (auto itor = symbolsPtr->GetChildIterator(); !itor->IsEof(); itor->MoveNext()) {
+            auto symbolPtr = itor->GetValue();
+            SymbolProfile symbol;
+            symbol.code = symbolPtr->Item("code")->ToString();
+            symbol.refPrice = Price::FromDouble(symbolPtr->Item("price")->ToDouble());
+            symbol.weight = GetNumber(symbolPtr, "weight", 0);
+            ReadSymbolCommon(symbolPtr, symbol);
+            if (symbol.code.empty() || symbol.code.size() >= sizeof(Order::stock_code) || symbol.weight < 0) {
+                throw library::utils::Exception("invalid workload symbol " + symbol.code);
+            }
+            // 参考价不在最小变动单位上时，生成的委托价格全部成为废单
+            if (!OrderBook::IsValidRefPrice(symbol.refPrice)) {
+                throw library::utils::Exception("workload symbol " + symbol.code + " price must be a positive multiple of 0.01");
+            }
+            profile.symbols.push_back(symbol);
+        }
+    }
+
+    // 批量生成的证券：代码从first_code起连续，参考价在[min_price, max_price]内按对数均匀分布
+    auto generatedPtr = FindItem(dataPtr, "generated_symbols");
+    if (generatedPtr) {
+        auto count = (int64_t)generatedPtr->Item("count")->ToDouble();
+        auto firstCode = (int64_t)GetNumber(generatedPtr, "first_code", 600000);
+        auto minPrice = GetNumber(generatedPtr, "min_price", 2);
+        auto maxPrice = GetNumber(generatedPtr, "max_price", 100);
+        if (count < 0 || firstCode < 0 || minPrice < 0.01 || maxPrice < minPrice) {
+            throw library::utils::Exception("workload generated_symbols requires count >= 0 and 0.01 <= min_price <= max_price");
+        }
+        SymbolProfile symbol;
+        ReadSymbolCommon(generatedPtr, symbol);
+        auto state = StreamState(profile.seed, 0, 0);
+        for (int64_t n = 0; n < count; n++) {
+            symbol.code = fmt::format("{:06d}", firstCode + n);
+            auto price = minPrice * std::pow(maxPrice / minPrice, NextUniform(state));
+            symbol.refPrice = Price::FromRaw(std::max<int64_t>(std::llround(price * 100), 1) * OrderBook::TICK_RAW);
+            profile.symbols.push_back(symbol);
+        }
+    }
+    return profile;
+}
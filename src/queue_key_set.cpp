@@ -0,0 +1,47 @@
+/**
+ * @file queue_key_set.cpp
+ * @brief 订单队列的键表
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "queue_key_set.h"
+
+#include <algorithm>
+#include <cstring>
+
+QueueKeySet::QueueKeySet(const std::string& queueName, int64_t queueCount)
+    : _prefix(queueName + "_") {
+    queueCount = std::max<int64_t>(queueCount, 1);
+    _keys.reserve(queueCount);
+    for (int64_t i = 0; i < queueCount; i++) {
+        _keys.push_back(_prefix + std::to_string(i));
+    }
+}
+
+int64_t QueueKeySet::IndexOf(const char* data, size_t size) const {
+    if (size <= _prefix.size() || memcmp(data, _prefix.data(), _prefix.size()) != 0) {
+        return -1;
+    }
+
+    int64_t idx = 0;
+    for (size_t i = _prefix.size(); i < size; i++) {
+        if (data[i] < '0' || data[i] > '9') {
+            return -1;
+        }
+        idx = idx * 10 + (data[i] - '0');
+        if (idx >= Size()) {
+            return -1;
+        }
+    }
+
+    // 长度不同说明带有前导0，不是本键表生成的键
+    return _keys[idx].size() == size ? idx : -1;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file queue_monitor.cpp
+ * @brief 队列积压监控
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "queue_monitor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "fmt/format.h"
+#include "redispp/redis_shards.h"
+#include "utils/time_utils.h"
+
+QueueMonitor::QueueMonitor(const MonitorOptions& options)
+    : _options(options), _queueKeys(options.queueName, std::max<int64_t>(options.queueCount, 1)) {
+    _options.queueCount = _queueKeys.Size();
+    _options.intervalMs = std::max<int64_t>(_options.intervalMs, 1);
+}
+
+bool QueueMonitor::Run() {
+    auto& shards = *library::redis::RedisShards::Instance();
+    std::vector<int64_t> depths;
+    std::vector<int64_t> pending;
+    do {
+        bool ok = true;
+        int64_t total = 0;
+        std::cout << library::utils::Time().ToString("%H:%M:%S") << std::endl;
+        for (int node = 0; node < shards.GetShardCount(); node++) {
+            try {
+                Query(node, depths, pending);
+            } catch (const sw::redis::Error& e) {
+                ok = false;
+                std::cout << "查询分片[" << node << "]失败:" << e.what() << std::endl;
+                continue;
+            }
+
+            int64_t sum = 0;
+            std::string detail;
+            for (int64_t i = 0; i < _options.queueCount; i++) {
+                sum += depths[i];
+                detail += fmt::format(" {}:{}", _queueKeys[i], depths[i]);
+                if (pending[i] >= 0) {
+                    detail += fmt::format("(待确认{})", pending[i]);
+                }
+            }
+            total += sum;
+            std::cout << (shards.GetShardCount() > 1 ? "分片[" + shards.GetShardName(node) + "]" : "") << "积压订单数:" << sum << detail
+                      << std::endl;
+        }
+        if (shards.GetShardCount() > 1) {
+            std::cout << "全部分片积压订单数:" << total << std::endl;
+        }
+
+        if (!_options.continuous) {
+            return ok;
+        }
+
+        // 分段等待，Stop后尽快退出
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_options.intervalMs);
+        while (!_stop.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::min<int64_t>(_options.intervalMs, 50)));
+        }
+    } while (!_stop.load(std::memory_order_relaxed));
+
+    return true;
+}
+
+void QueueMonitor::Query(int node, std::vector<int64_t>& depths, std::vector<int64_t>& pending) {
+    // 只读查询走从库，避免轮询占用主库
+    library::redis::RedisProxy redis(library::redis::RedisShards::Instance()->GetShard(node), -1, library::redis::RedisRole::Replica);
+    if (redis == nullptr) {
+        throw sw::redis::Error("Redis连接数不够");
+    }
+
+    depths.assign(_options.queueCount, 0);
+    pending.assign(_options.queueCount, -1);
+    try {
+        auto pipe = redis->pipeline(false);
+        for (auto& key : _queueKeys) {
+            if (_options.stream) {
+                pipe.command("XLEN", key).command("XPENDING", key, _options.group);
+            } else {
+                pipe.command("LLEN", key);
+            }
+        }
+        auto replies = pipe.exec();
+
+        size_t idx = 0;
+        for (int64_t i = 0; i < _options.queueCount; i++) {
+            depths[i] = replies.get<long long>(idx++);
+            if (!_options.stream) {
+                continue;
+            }
+
+            // XPENDING key group返回[待确认数, 最小id, 最大id, 各消费者]，消费组不存在时返回NOGROUP错误
+            try {
+                auto& summary = replies.get(idx);
+                if (summary.type == REDIS_REPLY_ARRAY && summary.elements > 0 && summary.element[0]->type == REDIS_REPLY_INTEGER) {
+                    pending[i] = summary.element[0]->integer;
+                }
+            } catch (const sw::redis::ReplyError&) {
+            }
+            ++idx;
+        }
+    } catch (const sw::redis::Error&) {
+        redis.SetInvalid();
+        throw;
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file rate_pacer.cpp
+ * @brief 开环定速发送的节拍器
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "rate_pacer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "utils/time_utils.h"
+
+static constexpr double SPIN_SECONDS = 200e-6;   // 距计划时间不足该值时自旋，否则先睡眠
+static constexpr int64_t LATE_NS = 1000000;      // 落后计划超过该值（纳秒）计为迟发
+
+RatePacer::RatePacer(const PaceOptions& options)
+    : _options(options) {
+    _options.burst = std::max<int64_t>(_options.burst, 1);
+    _options.rampSeconds = std::max(_options.rampSeconds, 0.0);
+}
+
+void RatePacer::Start() {
+    _cyclesPerSec = library::utils::Time::GetCyclesPerSec();
+    _startCycles = library::utils::Time::Rdtsc();
+    _startNano = library::utils::Time::NowNano();
+    _next = 0;
+    _maxLagNs = 0;
+    _lateCount = 0;
+}
+
+double RatePacer::ScheduleSeconds(int64_t k) const {
+    // 同一批突发的订单使用第一笔的计划时间
+    k = k / _options.burst * _options.burst;
+
+    // 爬坡段速率r(t)=rate*t/ramp，累计订单数N(t)=rate*t^2/(2*ramp)，之后每秒rate笔
+    auto ramp = _options.rampSeconds;
+    auto rampOrders = _options.rate * ramp / 2;
+    if (k < rampOrders) {
+        return std::sqrt(2 * ramp * k / _options.rate);
+    }
+    return ramp + (k - rampOrders) / _options.rate;
+}
+
+uint64_t RatePacer::NextCycles() const { return _startCycles + (uint64_t)(ScheduleSeconds(_next) * _cyclesPerSec); }
+
+bool RatePacer::Due() const { return !Enabled() || library::utils::Time::Rdtsc() >= NextCycles(); }
+
+int64_t RatePacer::Wait() {
+    if (!Enabled()) {
+        ++_next;
+        return library::utils::Time::NowNano();
+    }
+
+    auto seconds = ScheduleSeconds(_next);
+    auto target = _startCycles + (uint64_t)(seconds * _cyclesPerSec);
+    ++_next;
+
+    auto now = library::utils::Time::Rdtsc();
+    while (now < target) {
+        auto remain = (target - now) / _cyclesPerSec;
+        if (remain > SPIN_SECONDS) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(remain - SPIN_SECONDS));
+        }
+        now = library::utils::Time::Rdtsc();
+    }
+
+    auto lagNs = (int64_t)((now - target) / _cyclesPerSec * 1e9);
+    _maxLagNs = std::max(_maxLagNs, lagNs);
+    if (lagNs > LATE_NS) {
+        ++_lateCount;
+    }
+    return _startNano + (int64_t)(seconds * 1e9);
+}
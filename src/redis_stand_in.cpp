@@ -0,0 +1,1150 @@
+/**
+ * @file redis_stand_in.cpp
+ * @brief Redis替身服务
+ * @author
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr> <th>日期</th>       <th>作者</th> <th>修改说明</th> </tr>
+ * <tr> <td>2026-10-17</td> <td></td> <td>初始创建</td> </tr>
+ * </table>
+ */
+#include "redis_stand_in.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "utils/exception_utils.h"
+
+static constexpr int DB_COUNT = 16;               // 数据库数量，与redis默认配置一致
+static constexpr int WAIT_SLICE_MS = 100;         // 阻塞命令和接收线程检查停止标志的间隔（毫秒）
+static constexpr size_t MAX_INLINE_SIZE = 65536;  // 内联命令的最大长度
+
+static const char* WRONGTYPE_ERROR = "WRONGTYPE Operation against a key holding the wrong kind of value";
+static const char* INTEGER_ERROR = "ERR value is not an integer or out of range";
+static const char* SYNTAX_ERROR = "ERR syntax error";
+
+using Args = std::vector<std::string>;
+
+/**
+ * @brief 追加一个RESP头部，如"*3\r\n"、":5\r\n"
+ * @param out 输出
+ * @param type 类型字符
+ * @param value 长度或整数值
+ */
+static void AppendHeader(std::string& out, char type, int64_t value) {
+    char buf[24];
+    buf[0] = type;
+    auto end = std::to_chars(buf + 1, buf + sizeof(buf) - 2, value).ptr;
+    *end++ = '\r';
+    *end++ = '\n';
+    out.append(buf, end - buf);
+}
+
+static void AppendStatus(std::string& out, const char* status) {
+    out += '+';
+    out += status;
+    out += "\r\n";
+}
+
+static void AppendError(std::string& out, const std::string& error) {
+    out += '-';
+    out += error;
+    out += "\r\n";
+}
+
+static void AppendBulk(std::string& out, const std::string& value) {
+    AppendHeader(out, '$', (int64_t)value.size());
+    out += value;
+    out += "\r\n";
+}
+
+static void AppendNil(std::string& out) { out += "$-1\r\n"; }
+
+static void AppendNilArray(std::string& out) { out += "*-1\r\n"; }
+
+static std::string ToUpper(const std::string& value) {
+    std::string upper(value);
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return (char)toupper(c); });
+    return upper;
+}
+
+static bool ToInt(const char* begin, const char* end, int64_t& value) {
+    auto result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end && begin != end;
+}
+
+static bool ToInt(const std::string& str, int64_t& value) { return ToInt(str.data(), str.data() + str.size(), value); }
+
+static int64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief 从输入缓冲区解析一条命令，支持RESP数组和redis-cli的内联命令
+ * @param in 输入缓冲区
+ * @param pos 解析位置，成功时移动到命令之后
+ * @param args 输出命令参数
+ * @return int 1-解析出一条命令 0-数据不完整 -1-协议错误
+ */
+static int ParseCommand(const std::string& in, size_t& pos, Args& args) {
+    args.clear();
+    auto lineEnd = in.find("\r\n", pos);
+    if (lineEnd == std::string::npos) {
+        return in.size() - pos > MAX_INLINE_SIZE ? -1 : 0;
+    }
+
+    if (in[pos] != '*') {
+        for (size_t p = pos; p < lineEnd;) {
+            auto next = std::min(in.find(' ', p), lineEnd);
+            if (next > p) {
+                args.emplace_back(in, p, next - p);
+            }
+            p = next + 1;
+        }
+        pos = lineEnd + 2;
+        return 1;
+    }
+
+    int64_t count = 0;
+    if (!ToInt(in.data() + pos + 1, in.data() + lineEnd, count)) {
+        return -1;
+    }
+    auto p = lineEnd + 2;
+    for (int64_t i = 0; i < count; i++) {
+        lineEnd = in.find("\r\n", p);
+        if (lineEnd == std::string::npos) {
+            return 0;
+        }
+        int64_t len = 0;
+        if (in[p] != '$' || !ToInt(in.data() + p + 1, in.data() + lineEnd, len) || len < 0) {
+            return -1;
+        }
+        p = lineEnd + 2;
+        if (in.size() < p + len + 2) {
+            return 0;
+        }
+        args.emplace_back(in, p, len);
+        p += len + 2;
+    }
+    pos = p;
+    return 1;
+}
+
+struct RedisStandIn::Impl {
+    enum class Role { Sentinel, Master, Replica };
+    enum class Type { String, List, Stream };
+
+    // Stream消息id，ms-seq
+    struct StreamId {
+        uint64_t ms = 0;
+        uint64_t seq = 0;
+
+        bool operator<(const StreamId& other) const { return ms < other.ms || (ms == other.ms && seq < other.seq); }
+        bool operator<=(const StreamId& other) const { return !(other < *this); }
+        std::string ToString() const { return std::to_string(ms) + "-" + std::to_string(seq); }
+    };
+
+    // 消费组中已投递未确认的消息
+    struct PendingEntry {
+        std::string consumer;     // 消费者
+        int64_t deliveredMs = 0;  // 最近一次投递时间
+        int64_t deliveries = 0;   // 投递次数
+    };
+
+    struct Group {
+        StreamId lastDelivered;                    // 最后投递的消息id
+        std::map<StreamId, PendingEntry> pending;  // 待确认的消息
+    };
+
+    struct Stream {
+        StreamId lastId;                                       // 最后一条消息的id
+        std::map<StreamId, Args> entries;                      // 消息，字段和值交替排列
+        std::unordered_map<std::string, Group> groups;         // 消费组
+    };
+
+    struct Value {
+        Type type = Type::String;
+        std::string str;                // 字符串
+        std::deque<std::string> list;   // 列表
+        std::unique_ptr<Stream> stream; // Stream
+    };
+
+    using Database = std::unordered_map<std::string, Value>;
+
+    // 连接级状态
+    struct Session {
+        Role role;   // 所连接的端口角色
+        int db = 0;  // 当前数据库
+    };
+
+    struct Listener {
+        int fd = -1;
+        int port = 0;
+        Role role;
+    };
+
+    struct Connection {
+        int fd = -1;
+        Role role;
+        std::thread thread;
+        bool closed = false;  // 连接线程已关闭fd并即将退出，由connMutex保护
+    };
+
+    using Handler = void (Impl::*)(Session&, const Args&, std::string&, std::unique_lock<std::mutex>&);
+
+    struct Command {
+        Handler handler;  // 处理函数，调用时持有dataMutex
+        size_t minArgs;   // 最少参数个数，包括命令名
+        bool write;       // 是否为写命令，从库拒绝执行
+    };
+
+    StandInOptions options;
+    std::vector<Listener> listeners;
+    std::thread acceptThread;
+    std::atomic<bool> stop{false};
+
+    std::mutex connMutex;
+    std::list<Connection> connections;
+
+    std::mutex dataMutex;
+    std::condition_variable dataCond;  // 有新数据写入时通知阻塞命令
+    Database dbs[DB_COUNT];
+    std::atomic<int64_t> commandCount{0};
+
+    explicit Impl(const StandInOptions& opts)
+        : options(opts) {}
+
+    int Listen(int port) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            throw library::utils::Exception(std::string("stand-in socket failed: ") + strerror(errno));
+        }
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        if (inet_pton(AF_INET, options.host.c_str(), &addr.sin_addr) != 1) {
+            close(fd);
+            throw library::utils::Exception("invalid stand-in host " + options.host);
+        }
+        if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 128) < 0) {
+            std::string err = strerror(errno);
+            close(fd);
+            throw library::utils::Exception("stand-in failed to listen on " + options.host + ":" + std::to_string(port) + ": " + err);
+        }
+        return fd;
+    }
+
+    void AddListener(int port, Role role) {
+        Listener listener;
+        listener.fd = Listen(port);
+        listener.role = role;
+        sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        getsockname(listener.fd, (sockaddr*)&addr, &len);
+        listener.port = ntohs(addr.sin_port);
+        listeners.push_back(listener);
+    }
+
+    int GetPort(Role role) const {
+        for (auto& listener : listeners) {
+            if (listener.role == role) {
+                return listener.port;
+            }
+        }
+        return 0;
+    }
+
+    void AcceptLoop() {
+        std::vector<pollfd> fds;
+        for (auto& listener : listeners) {
+            fds.push_back({listener.fd, POLLIN, 0});
+        }
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (poll(fds.data(), fds.size(), WAIT_SLICE_MS) > 0) {
+                for (size_t i = 0; i < fds.size(); i++) {
+                    if (!(fds[i].revents & POLLIN)) {
+                        continue;
+                    }
+                    int fd = accept(fds[i].fd, nullptr, nullptr);
+                    if (fd < 0) {
+                        continue;
+                    }
+                    int on = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+                    std::lock_guard<std::mutex> lock(connMutex);
+                    connections.emplace_back();
+                    auto& conn = connections.back();
+                    conn.fd = fd;
+                    conn.role = listeners[i].role;
+                    conn.thread = std::thread(&Impl::Serve, this, &conn);
+                }
+            }
+
+            // 回收已断开的连接
+            std::lock_guard<std::mutex> lock(connMutex);
+            for (auto itor = connections.begin(); itor != connections.end();) {
+                if (itor->closed) {
+                    itor->thread.join();
+                    itor = connections.erase(itor);
+                } else {
+                    ++itor;
+                }
+            }
+        }
+    }
+
+    static bool SendAll(int fd, const std::string& out) {
+        size_t sent = 0;
+        while (sent < out.size()) {
+            auto n = send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            sent += n;
+        }
+        return true;
+    }
+
+    void Serve(Connection* conn) {
+        Session session{conn->role};
+        std::string in;
+        std::string out;
+        Args args;
+        char buf[65536];
+        bool quit = false;
+        while (!quit && !stop.load(std::memory_order_relaxed)) {
+            auto n = recv(conn->fd, buf, sizeof(buf), 0);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            in.append(buf, n);
+
+            // 一次读到的全部命令（pipeline）执行完后一起回复
+            size_t pos = 0;
+            out.clear();
+            while (!quit && pos < in.size()) {
+                auto status = ParseCommand(in, pos, args);
+                if (status == 0) {
+                    break;
+                }
+                if (status < 0) {
+                    AppendError(out, "ERR Protocol error");
+                    quit = true;
+                } else if (!args.empty()) {
+                    quit = !Execute(session, args, out);
+                }
+            }
+            in.erase(0, pos);
+
+            if (!out.empty()) {
+                if (options.latencyUs > 0 && session.role != Role::Sentinel) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(options.latencyUs));
+                }
+                if (!SendAll(conn->fd, out)) {
+                    break;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(connMutex);
+        close(conn->fd);
+        conn->closed = true;
+    }
+
+    /**
+     * @brief 执行一条命令
+     * @return false 客户端发送了QUIT，回复后关闭连接
+     */
+    bool Execute(Session& session, const Args& args, std::string& out) {
+        auto name = ToUpper(args[0]);
+        if (name == "QUIT") {
+            AppendStatus(out, "OK");
+            return false;
+        }
+        if (name == "PING") {
+            args.size() > 1 ? AppendBulk(out, args[1]) : AppendStatus(out, "PONG");
+            return true;
+        }
+        if (name == "AUTH" || name == "CLIENT") {
+            AppendStatus(out, "OK");
+            return true;
+        }
+        if (name == "ROLE") {
+            ReplyRole(session, out);
+            return true;
+        }
+        if (session.role == Role::Sentinel) {
+            name == "SENTINEL" && args.size() >= 2 ? ReplySentinel(args, out) : AppendError(out, "ERR unknown command '" + args[0] + "'");
+            return true;
+        }
+
+        commandCount.fetch_add(1, std::memory_order_relaxed);
+        if (name == "SELECT") {
+            int64_t db = 0;
+            if (args.size() != 2 || !ToInt(args[1], db) || db < 0 || db >= DB_COUNT) {
+                AppendError(out, "ERR DB index is out of range");
+            } else {
+                session.db = (int)db;
+                AppendStatus(out, "OK");
+            }
+            return true;
+        }
+        if (name == "INFO") {
+            ReplyInfo(session, out);
+            return true;
+        }
+
+        static const std::unordered_map<std::string, Command> commands = {
+            {"GET", {&Impl::Get, 2, false}},
+            {"DEL", {&Impl::Del, 2, true}},
+            {"FLUSHDB", {&Impl::FlushDb, 1, true}},
+            {"FLUSHALL", {&Impl::FlushAll, 1, true}},
+            {"INCR", {&Impl::IncrBy, 2, true}},
+            {"INCRBY", {&Impl::IncrBy, 3, true}},
+            {"RPUSH", {&Impl::RPush, 3, true}},
+            {"LPOP", {&Impl::LPop, 2, true}},
+            {"BLPOP", {&Impl::BLPop, 3, true}},
+            {"LLEN", {&Impl::LLen, 2, false}},
+            {"XADD", {&Impl::XAdd, 5, true}},
+            {"XLEN", {&Impl::XLen, 2, false}},
+            {"XGROUP", {&Impl::XGroup, 5, true}},
+            {"XREADGROUP", {&Impl::XReadGroup, 7, true}},
+            {"XACK", {&Impl::XAck, 4, true}},
+            {"XDEL", {&Impl::XDel, 3, true}},
+            {"XPENDING", {&Impl::XPending, 3, false}},
+            {"XAUTOCLAIM", {&Impl::XAutoClaim, 6, true}},
+        };
+        auto itor = commands.find(name);
+        if (itor == commands.end()) {
+            AppendError(out, "ERR unknown command '" + args[0] + "'");
+        } else if (args.size() < itor->second.minArgs) {
+            AppendError(out, "ERR wrong number of arguments for '" + args[0] + "' command");
+        } else if (itor->second.write && session.role == Role::Replica) {
+            AppendError(out, "READONLY You can't write against a read only replica.");
+        } else {
+            std::unique_lock<std::mutex> lock(dataMutex);
+            (this->*itor->second.handler)(session, args, out, lock);
+        }
+        return true;
+    }
+
+    void ReplyRole(const Session& session, std::string& out) {
+        if (session.role == Role::Replica) {
+            AppendHeader(out, '*', 5);
+            AppendBulk(out, "slave");
+            AppendBulk(out, options.host);
+            AppendHeader(out, ':', GetPort(Role::Master));
+            AppendBulk(out, "connected");
+            AppendHeader(out, ':', 0);
+        } else if (session.role == Role::Master) {
+            AppendHeader(out, '*', 3);
+            AppendBulk(out, "master");
+            AppendHeader(out, ':', 0);
+            AppendHeader(out, '*', 1);
+            AppendHeader(out, '*', 3);
+            AppendBulk(out, options.host);
+            AppendBulk(out, std::to_string(GetPort(Role::Replica)));
+            AppendBulk(out, "0");
+        } else {
+            AppendHeader(out, '*', 2);
+            AppendBulk(out, "sentinel");
+            AppendHeader(out, '*', 0);
+        }
+    }
+
+    void ReplyInfo(const Session& session, std::string& out) {
+        std::string info = "# Replication\r\n";
+        if (session.role == Role::Replica) {
+            info += "role:slave\r\nmaster_host:" + options.host + "\r\nmaster_port:" + std::to_string(GetPort(Role::Master)) +
+                    "\r\nmaster_link_status:up\r\n";
+        } else {
+            info += "role:master\r\nconnected_slaves:1\r\n";
+        }
+        AppendBulk(out, info);
+    }
+
+    // 哨兵只知道一个主库，对任意主库名称都返回它
+    void ReplySentinel(const Args& args, std::string& out) {
+        auto sub = ToUpper(args[1]);
+        if (sub == "GET-MASTER-ADDR-BY-NAME") {
+            AppendHeader(out, '*', 2);
+            AppendBulk(out, options.host);
+            AppendBulk(out, std::to_string(GetPort(Role::Master)));
+        } else if (sub == "SLAVES" || sub == "REPLICAS") {
+            AppendHeader(out, '*', 1);
+            AppendHeader(out, '*', 8);
+            AppendBulk(out, "ip");
+            AppendBulk(out, options.host);
+            AppendBulk(out, "port");
+            AppendBulk(out, std::to_string(GetPort(Role::Replica)));
+            AppendBulk(out, "flags");
+            AppendBulk(out, "slave");
+            AppendBulk(out, "master-link-status");
+            AppendBulk(out, "ok");
+        } else if (sub == "SENTINELS") {
+            AppendHeader(out, '*', 0);
+        } else {
+            AppendError(out, "ERR Unknown sentinel subcommand '" + args[1] + "'");
+        }
+    }
+
+    /**
+     * @brief 查找键
+     * @param value 输出值，键不存在时为nullptr
+     * @return false 键的类型不符，已输出WRONGTYPE错误
+     */
+    bool Lookup(Database& db, const std::string& key, Type type, Value*& value, std::string& out) {
+        auto itor = db.find(key);
+        value = itor == db.end() ? nullptr : &itor->second;
+        if (value && value->type != type) {
+            AppendError(out, WRONGTYPE_ERROR);
+            return false;
+        }
+        return true;
+    }
+
+    Value& Create(Database& db, const std::string& key, Type type) {
+        auto& value = db[key];
+        value.type = type;
+        if (type == Type::Stream) {
+            value.stream.reset(new Stream());
+        }
+        return value;
+    }
+
+    /**
+     * @brief 等待新数据写入，直到deadline或停止
+     * @param deadline 截止时间，为空时一直等待
+     * @return false 已超时或停止
+     */
+    bool Wait(std::unique_lock<std::mutex>& lock, const std::chrono::steady_clock::time_point* deadline) {
+        auto now = std::chrono::steady_clock::now();
+        if (stop.load(std::memory_order_relaxed) || (deadline && now >= *deadline)) {
+            return false;
+        }
+        auto until = now + std::chrono::milliseconds(WAIT_SLICE_MS);
+        dataCond.wait_until(lock, deadline ? std::min(until, *deadline) : until);
+        return true;
+    }
+
+    void Get(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        Value* value = nullptr;
+        if (Lookup(dbs[session.db], args[1], Type::String, value, out)) {
+            value ? AppendBulk(out, value->str) : AppendNil(out);
+        }
+    }
+
+    void Del(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        int64_t count = 0;
+        for (size_t i = 1; i < args.size(); i++) {
+            count += (int64_t)dbs[session.db].erase(args[i]);
+        }
+        AppendHeader(out, ':', count);
+    }
+
+    void FlushDb(Session& session, const Args&, std::string& out, std::unique_lock<std::mutex>&) {
+        dbs[session.db].clear();
+        AppendStatus(out, "OK");
+    }
+
+    void FlushAll(Session&, const Args&, std::string& out, std::unique_lock<std::mutex>&) {
+        for (auto& db : dbs) {
+            db.clear();
+        }
+        AppendStatus(out, "OK");
+    }
+
+    void IncrBy(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        int64_t delta = 1;
+        if (args.size() > 2 && !ToInt(args[2], delta)) {
+            AppendError(out, INTEGER_ERROR);
+            return;
+        }
+        Value* value = nullptr;
+        if (!Lookup(dbs[session.db], args[1], Type::String, value, out)) {
+            return;
+        }
+        int64_t current = 0;
+        if (value && !ToInt(value->str, current)) {
+            AppendError(out, INTEGER_ERROR);
+            return;
+        }
+        if (!value) {
+            value = &Create(dbs[session.db], args[1], Type::String);
+        }
+        current += delta;
+        value->str = std::to_string(current);
+        AppendHeader(out, ':', current);
+    }
+
+    void RPush(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        Value* value = nullptr;
+        if (!Lookup(dbs[session.db], args[1], Type::List, value, out)) {
+            return;
+        }
+        if (!value) {
+            value = &Create(dbs[session.db], args[1], Type::List);
+        }
+        value->list.insert(value->list.end(), args.begin() + 2, args.end());
+        AppendHeader(out, ':', (int64_t)value->list.size());
+        dataCond.notify_all();
+    }
+
+    void LPop(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        int64_t count = -1;
+        if (args.size() > 2 && (!ToInt(args[2], count) || count < 0)) {
+            AppendError(out, "ERR value is out of range, must be positive");
+            return;
+        }
+        Value* value = nullptr;
+        if (!Lookup(dbs[session.db], args[1], Type::List, value, out)) {
+            return;
+        }
+        if (!value) {
+            count < 0 ? AppendNil(out) : AppendNilArray(out);
+            return;
+        }
+
+        if (count < 0) {
+            AppendBulk(out, value->list.front());
+            value->list.pop_front();
+        } else {
+            count = std::min<int64_t>(count, value->list.size());
+            AppendHeader(out, '*', count);
+            for (int64_t i = 0; i < count; i++) {
+                AppendBulk(out, value->list.front());
+                value->list.pop_front();
+            }
+        }
+        if (value->list.empty()) {
+            dbs[session.db].erase(args[1]);
+        }
+    }
+
+    void BLPop(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>& lock) {
+        char* end = nullptr;
+        double timeout = strtod(args.back().c_str(), &end);
+        if (end != args.back().c_str() + args.back().size() || timeout < 0) {
+            AppendError(out, "ERR timeout is not a float or out of range");
+            return;
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((int64_t)(timeout * 1000000));
+
+        // 与redis一致，按键的顺序弹出第一个非空列表的队首
+        do {
+            auto& db = dbs[session.db];
+            for (size_t i = 1; i + 1 < args.size(); i++) {
+                Value* value = nullptr;
+                if (!Lookup(db, args[i], Type::List, value, out)) {
+                    return;
+                }
+                if (value) {
+                    AppendHeader(out, '*', 2);
+                    AppendBulk(out, args[i]);
+                    AppendBulk(out, value->list.front());
+                    value->list.pop_front();
+                    if (value->list.empty()) {
+                        db.erase(args[i]);
+                    }
+                    return;
+                }
+            }
+        } while (Wait(lock, timeout > 0 ? &deadline : nullptr));
+        AppendNilArray(out);
+    }
+
+    void LLen(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        Value* value = nullptr;
+        if (Lookup(dbs[session.db], args[1], Type::List, value, out)) {
+            AppendHeader(out, ':', value ? (int64_t)value->list.size() : 0);
+        }
+    }
+
+    /**
+     * @brief 解析Stream消息id，支持ms-seq、ms、-和+
+     */
+    static bool ParseId(const std::string& str, StreamId& id) {
+        if (str == "-") {
+            id = StreamId();
+            return true;
+        }
+        if (str == "+") {
+            id = StreamId{UINT64_MAX, UINT64_MAX};
+            return true;
+        }
+        auto dash = str.find('-');
+        auto msEnd = dash == std::string::npos ? str.data() + str.size() : str.data() + dash;
+        auto msResult = std::from_chars(str.data(), msEnd, id.ms);
+        if (msResult.ec != std::errc() || msResult.ptr != msEnd || msEnd == str.data()) {
+            return false;
+        }
+        id.seq = 0;
+        if (dash == std::string::npos) {
+            return true;
+        }
+        auto seqEnd = str.data() + str.size();
+        auto seqResult = std::from_chars(str.data() + dash + 1, seqEnd, id.seq);
+        return seqResult.ec == std::errc() && seqResult.ptr == seqEnd && dash + 1 < str.size();
+    }
+
+    static void AppendEntry(std::string& out, const StreamId& id, const Args* fields) {
+        AppendHeader(out, '*', 2);
+        AppendBulk(out, id.ToString());
+        if (!fields) {
+            AppendNilArray(out);
+            return;
+        }
+        AppendHeader(out, '*', (int64_t)fields->size());
+        for (auto& field : *fields) {
+            AppendBulk(out, field);
+        }
+    }
+
+    static Group* FindGroup(Stream& stream, const std::string& group) {
+        auto itor = stream.groups.find(group);
+        return itor == stream.groups.end() ? nullptr : &itor->second;
+    }
+
+    /**
+     * @brief 查找消费组，Stream或消费组不存在时输出NOGROUP错误
+     */
+    Group* FindGroup(Session& session, const std::string& key, const std::string& group, Stream*& stream, std::string& out) {
+        Value* value = nullptr;
+        if (!Lookup(dbs[session.db], key, Type::Stream, value, out)) {
+            return nullptr;
+        }
+        auto groupPtr = value ? FindGroup(*value->stream, group) : nullptr;
+        if (!groupPtr) {
+            AppendError(out, "NOGROUP No such key '" + key + "' or consumer group '" + group + "'");
+            return nullptr;
+        }
+        stream = value->stream.get();
+        return groupPtr;
+    }
+
+    void XAdd(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        size_t i = 2;
+        int64_t maxLen = -1;
+        if (ToUpper(args[i]) == "MAXLEN") {
+            ++i;
+            if (i < args.size() && (args[i] == "~" || args[i] == "=")) {
+                ++i;
+            }
+            if (i >= args.size() || !ToInt(args[i], maxLen) || maxLen < 0) {
+                AppendError(out, INTEGER_ERROR);
+                return;
+            }
+            ++i;
+        }
+        if (i + 3 > args.size() || (args.size() - i - 1) % 2 != 0) {
+            AppendError(out, "ERR wrong number of arguments for 'xadd' command");
+            return;
+        }
+
+        Value* value = nullptr;
+        if (!Lookup(dbs[session.db], args[1], Type::Stream, value, out)) {
+            return;
+        }
+        StreamId id;
+        auto lastId = value ? value->stream->lastId : StreamId();
+        if (args[i] == "*") {
+            id.ms = (uint64_t)NowMs();
+            if (id.ms <= lastId.ms) {
+                id = StreamId{lastId.ms, lastId.seq + 1};
+            }
+        } else if (!ParseId(args[i], id)) {
+            AppendError(out, "ERR Invalid stream ID specified as stream command argument");
+            return;
+        } else if (id <= lastId) {
+            AppendError(out, "ERR The ID specified in XADD is equal or smaller than the target stream top item");
+            return;
+        }
+        if (!value) {
+            value = &Create(dbs[session.db], args[1], Type::Stream);
+        }
+
+        auto& stream = *value->stream;
+        stream.lastId = id;
+        stream.entries.emplace(id, Args(args.begin() + i + 1, args.end()));
+        while (maxLen >= 0 && (int64_t)stream.entries.size() > maxLen) {
+            stream.entries.erase(stream.entries.begin());
+        }
+        AppendBulk(out, id.ToString());
+        dataCond.notify_all();
+    }
+
+    void XLen(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        Value* value = nullptr;
+        if (Lookup(dbs[session.db], args[1], Type::Stream, value, out)) {
+            AppendHeader(out, ':', value ? (int64_t)value->stream->entries.size() : 0);
+        }
+    }
+
+    void XGroup(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        if (ToUpper(args[1]) != "CREATE") {
+            AppendError(out, "ERR unknown subcommand '" + args[1] + "'");
+            return;
+        }
+        Value* value = nullptr;
+        if (!Lookup(dbs[session.db], args[2], Type::Stream, value, out)) {
+            return;
+        }
+        if (!value) {
+            if (args.size() < 6 || ToUpper(args[5]) != "MKSTREAM") {
+                AppendError(out, "ERR The XGROUP subcommand requires the key to exist");
+                return;
+            }
+            value = &Create(dbs[session.db], args[2], Type::Stream);
+        }
+
+        auto& stream = *value->stream;
+        StreamId start = stream.lastId;
+        if (args[4] != "$" && !ParseId(args[4], start)) {
+            AppendError(out, "ERR Invalid stream ID specified as stream command argument");
+            return;
+        }
+        if (stream.groups.count(args[3])) {
+            AppendError(out, "BUSYGROUP Consumer Group name already exists");
+            return;
+        }
+        stream.groups[args[3]].lastDelivered = start;
+        AppendStatus(out, "OK");
+    }
+
+    void XReadGroup(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>& lock) {
+        if (ToUpper(args[1]) != "GROUP") {
+            AppendError(out, SYNTAX_ERROR);
+            return;
+        }
+        auto& group = args[2];
+        auto& consumer = args[3];
+        int64_t count = 0;
+        int64_t blockMs = -1;
+        bool noAck = false;
+        size_t i = 4;
+        for (; i < args.size(); i++) {
+            auto option = ToUpper(args[i]);
+            if (option == "STREAMS") {
+                break;
+            } else if (option == "COUNT" && i + 1 < args.size() && ToInt(args[i + 1], count)) {
+                ++i;
+            } else if (option == "BLOCK" && i + 1 < args.size() && ToInt(args[i + 1], blockMs)) {
+                ++i;
+            } else if (option == "NOACK") {
+                noAck = true;
+            } else {
+                AppendError(out, SYNTAX_ERROR);
+                return;
+            }
+        }
+        auto rest = args.size() - std::min(i + 1, args.size());
+        if (i >= args.size() || rest == 0 || rest % 2 != 0) {
+            AppendError(out, "ERR Unbalanced 'xreadgroup' list of streams: for each stream key an ID or '>' must be specified.");
+            return;
+        }
+        size_t keyCount = rest / 2;
+        size_t firstKey = i + 1;
+
+        // 只有'>'读取新消息，可以阻塞；指定id读取本消费者的待确认消息，立即返回
+        bool history = false;
+        for (size_t k = 0; k < keyCount; k++) {
+            history = history || args[firstKey + keyCount + k] != ">";
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max<int64_t>(blockMs, 0));
+
+        std::string body;
+        do {
+            body.clear();
+            int64_t streamCount = 0;
+            for (size_t k = 0; k < keyCount; k++) {
+                auto& key = args[firstKey + k];
+                auto& start = args[firstKey + keyCount + k];
+                Stream* stream = nullptr;
+                auto groupPtr = FindGroup(session, key, group, stream, out);
+                if (!groupPtr) {
+                    return;
+                }
+
+                std::string entries;
+                int64_t n = 0;
+                auto nowMs = NowMs();
+                if (start == ">") {
+                    for (auto itor = stream->entries.upper_bound(groupPtr->lastDelivered);
+                         itor != stream->entries.end() && (count <= 0 || n < count); ++itor, ++n) {
+                        AppendEntry(entries, itor->first, &itor->second);
+                        groupPtr->lastDelivered = itor->first;
+                        if (!noAck) {
+                            groupPtr->pending[itor->first] = PendingEntry{consumer, nowMs, 1};
+                        }
+                    }
+                    if (n == 0) {
+                        continue;
+                    }
+                } else {
+                    StreamId id;
+                    if (!ParseId(start, id)) {
+                        AppendError(out, "ERR Invalid stream ID specified as stream command argument");
+                        return;
+                    }
+                    for (auto itor = groupPtr->pending.upper_bound(id); itor != groupPtr->pending.end() && (count <= 0 || n < count); ++itor) {
+                        if (itor->second.consumer != consumer) {
+                            continue;
+                        }
+                        auto entry = stream->entries.find(itor->first);
+                        AppendEntry(entries, itor->first, entry == stream->entries.end() ? nullptr : &entry->second);
+                        itor->second.deliveredMs = nowMs;
+                        ++itor->second.deliveries;
+                        ++n;
+                    }
+                }
+
+                AppendHeader(body, '*', 2);
+                AppendBulk(body, key);
+                AppendHeader(body, '*', n);
+                body += entries;
+                ++streamCount;
+            }
+
+            if (streamCount > 0) {
+                AppendHeader(out, '*', streamCount);
+                out += body;
+                return;
+            }
+        } while (blockMs >= 0 && !history && Wait(lock, blockMs > 0 ? &deadline : nullptr));
+        AppendNilArray(out);
+    }
+
+    void XAck(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        Value* value = nullptr;
+        if (!Lookup(dbs[session.db], args[1], Type::Stream, value, out)) {
+            return;
+        }
+        int64_t count = 0;
+        auto group = value ? FindGroup(*value->stream, args[2]) : nullptr;
+        for (size_t i = 3; group && i < args.size(); i++) {
+            StreamId id;
+            if (!ParseId(args[i], id)) {
+                AppendError(out, "ERR Invalid stream ID specified as stream command argument");
+                return;
+            }
+            count += (int64_t)group->pending.erase(id);
+        }
+        AppendHeader(out, ':', count);
+    }
+
+    void XDel(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        Value* value = nullptr;
+        if (!Lookup(dbs[session.db], args[1], Type::Stream, value, out)) {
+            return;
+        }
+        int64_t count = 0;
+        for (size_t i = 2; value && i < args.size(); i++) {
+            StreamId id;
+            if (!ParseId(args[i], id)) {
+                AppendError(out, "ERR Invalid stream ID specified as stream command argument");
+                return;
+            }
+            count += (int64_t)value->stream->entries.erase(id);
+        }
+        AppendHeader(out, ':', count);
+    }
+
+    // 只支持汇总形式: XPENDING key group
+    void XPending(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        if (args.size() != 3) {
+            AppendError(out, SYNTAX_ERROR);
+            return;
+        }
+        Stream* stream = nullptr;
+        auto group = FindGroup(session, args[1], args[2], stream, out);
+        if (!group) {
+            return;
+        }
+
+        AppendHeader(out, '*', 4);
+        AppendHeader(out, ':', (int64_t)group->pending.size());
+        if (group->pending.empty()) {
+            AppendNil(out);
+            AppendNil(out);
+            AppendNilArray(out);
+            return;
+        }
+        AppendBulk(out, group->pending.begin()->first.ToString());
+        AppendBulk(out, group->pending.rbegin()->first.ToString());
+        std::map<std::string, int64_t> consumers;
+        for (auto& item : group->pending) {
+            ++consumers[item.second.consumer];
+        }
+        AppendHeader(out, '*', (int64_t)consumers.size());
+        for (auto& item : consumers) {
+            AppendHeader(out, '*', 2);
+            AppendBulk(out, item.first);
+            AppendBulk(out, std::to_string(item.second));
+        }
+    }
+
+    // XAUTOCLAIM key group consumer min-idle-time start [COUNT count]，按redis 7返回[下一个起点, 认领的消息, 已删除的id]
+    void XAutoClaim(Session& session, const Args& args, std::string& out, std::unique_lock<std::mutex>&) {
+        int64_t minIdle = 0;
+        int64_t count = 100;
+        StreamId start;
+        if (!ToInt(args[4], minIdle) || !ParseId(args[5], start)) {
+            AppendError(out, SYNTAX_ERROR);
+            return;
+        }
+        for (size_t i = 6; i < args.size(); i++) {
+            if (ToUpper(args[i]) == "COUNT" && i + 1 < args.size() && ToInt(args[i + 1], count) && count > 0) {
+                ++i;
+            } else {
+                AppendError(out, SYNTAX_ERROR);
+                return;
+            }
+        }
+        Stream* stream = nullptr;
+        auto group = FindGroup(session, args[1], args[2], stream, out);
+        if (!group) {
+            return;
+        }
+
+        auto nowMs = NowMs();
+        std::string claimed;
+        std::string deleted;
+        int64_t claimedCount = 0;
+        int64_t deletedCount = 0;
+        auto itor = group->pending.lower_bound(start);
+        for (int64_t scanned = 0; itor != group->pending.end() && scanned < count; scanned++) {
+            if (nowMs - itor->second.deliveredMs < minIdle) {
+                ++itor;
+                continue;
+            }
+            auto entry = stream->entries.find(itor->first);
+            if (entry == stream->entries.end()) {
+                AppendBulk(deleted, itor->first.ToString());
+                ++deletedCount;
+                itor = group->pending.erase(itor);
+                continue;
+            }
+            itor->second.consumer = args[3];
+            itor->second.deliveredMs = nowMs;
+            ++itor->second.deliveries;
+            AppendEntry(claimed, itor->first, &entry->second);
+            ++claimedCount;
+            ++itor;
+        }
+
+        AppendHeader(out, '*', 3);
+        AppendBulk(out, itor == group->pending.end() ? "0-0" : itor->first.ToString());
+        AppendHeader(out, '*', claimedCount);
+        out += claimed;
+        AppendHeader(out, '*', deletedCount);
+        out += deleted;
+    }
+};
+
+RedisStandIn::RedisStandIn(const StandInOptions& options)
+    : _impl(new Impl(options)) {}
+
+RedisStandIn::~RedisStandIn() { Stop(); }
+
+void RedisStandIn::Start() {
+    if (!_impl->listeners.empty()) {
+        return;
+    }
+
+    try {
+        for (auto port : _impl->options.sentinelPorts) {
+            _impl->AddListener(port, Impl::Role::Sentinel);
+        }
+        _impl->AddListener(_impl->options.masterPort, Impl::Role::Master);
+        _impl->AddListener(_impl->options.replicaPort, Impl::Role::Replica);
+    } catch (...) {
+        for (auto& listener : _impl->listeners) {
+            close(listener.fd);
+        }
+        _impl->listeners.clear();
+        throw;
+    }
+    _impl->acceptThread = std::thread(&Impl::AcceptLoop, _impl.get());
+}
+
+void RedisStandIn::Stop() {
+    if (!_impl->acceptThread.joinable()) {
+        return;
+    }
+
+    _impl->stop.store(true, std::memory_order_relaxed);
+    _impl->acceptThread.join();
+    for (auto& listener : _impl->listeners) {
+        close(listener.fd);
+    }
+
+    // 唤醒阻塞在recv和阻塞命令上的连接线程
+    {
+        std::lock_guard<std::mutex> lock(_impl->connMutex);
+        for (auto& conn : _impl->connections) {
+            if (!conn.closed) {
+                shutdown(conn.fd, SHUT_RDWR);
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_impl->dataMutex);
+    }
+    _impl->dataCond.notify_all();
+    for (auto& conn : _impl->connections) {
+        conn.thread.join();
+    }
+    _impl->connections.clear();
+}
+
+const std::string& RedisStandIn::GetHost() const { return _impl->options.host; }
+
+std::vector<int> RedisStandIn::GetSentinelPorts() const {
+    std::vector<int> ports;
+    for (auto& listener : _impl->listeners) {
+        if (listener.role == Impl::Role::Sentinel) {
+            ports.push_back(listener.port);
+        }
+    }
+    return ports;
+}
+
+int RedisStandIn::GetMasterPort() const { return _impl->GetPort(Impl::Role::Master); }
+
+int RedisStandIn::GetReplicaPort() const { return _impl->GetPort(Impl::Role::Replica); }
+
+int64_t RedisStandIn::GetCommandCount() const { return _impl->commandCount.load(std::memory_order_relaxed); }